@@ -0,0 +1,138 @@
+#include "benchmark.h"
+
+#include <Arduino.h>
+#include <esp_cpu.h>
+#include <lvgl.h>
+
+#include "config.h"
+#include "fixed_osc.h"
+#include "maestro_batch.h"
+#include "sequence_engine.h"
+#include "servo_tx_queue.h"
+
+// =============================================================================
+// ON-DEVICE BENCHMARK SUITE IMPLEMENTATION
+// =============================================================================
+
+// Defined in the sketch
+void generateDynamicKeyframe(unsigned long currentTime, bool isTalking);
+extern MaestroBatch maestroBatch;
+
+// Sink that keeps the optimizer from discarding benchmarked computations
+static volatile uint32_t benchSink;
+
+static void printResult(const char* name, uint32_t iterations, uint32_t totalCycles) {
+    Serial.print("bench,");
+    Serial.print(name);
+    Serial.print(",");
+    Serial.print(iterations);
+    Serial.print(",");
+    Serial.print(totalCycles);
+    Serial.print(",");
+    Serial.println(totalCycles / iterations);
+}
+
+// Eye animation interpolation: the integer easing + position math the
+// animation callback performs per tick
+static void benchEyeInterpolation() {
+    const uint32_t N = 10000;
+    uint32_t start = esp_cpu_get_cycle_count();
+    for (uint32_t i = 0; i < N; i++) {
+        int32_t v = i & 0xFF;
+        int16_t h = (int16_t)(EYE_H_LEFT + (int32_t)(EYE_H_RIGHT - EYE_H_LEFT) * v / 256);
+        int16_t vv = (int16_t)(EYE_V_UP + (int32_t)(EYE_V_DOWN - EYE_V_UP) * v / 256);
+        benchSink += (uint16_t)h + (uint16_t)vv;
+    }
+    printResult("eye_interp", N, esp_cpu_get_cycle_count() - start);
+}
+
+// Keyframe easing + servo interpolation as used by scripted playback
+static void benchKeyframeInterpolation() {
+    const uint32_t N = 10000;
+    Keyframe from = {0, {PAN_LEFT, NOD_UP, JAW_CLOSED}, EYE_H_LEFT, EYE_V_UP};
+    Keyframe to = {1000, {PAN_RIGHT, NOD_DOWN, JAW_OPEN}, EYE_H_RIGHT, EYE_V_DOWN};
+    uint16_t positions[NUM_SERVOS];
+
+    uint32_t start = esp_cpu_get_cycle_count();
+    for (uint32_t i = 0; i < N; i++) {
+        uint16_t t = easeInOutQ8_8(i % 1000, 1000);
+        interpolateKeyframe(from, to, t, positions);
+        benchSink += positions[0];
+    }
+    printResult("keyframe_interp", N, esp_cpu_get_cycle_count() - start);
+}
+
+// Dynamic keyframe generation (random positions land in the arbiter's
+// claim table; the suite runs before the motion task starts, so nothing
+// resolves them to the UART)
+static void benchDynamicKeyframe() {
+    const uint32_t N = 1000;
+    uint32_t start = esp_cpu_get_cycle_count();
+    for (uint32_t i = 0; i < N; i++) {
+        generateDynamicKeyframe(i * 10, false);
+    }
+    printResult("dyn_keyframe", N, esp_cpu_get_cycle_count() - start);
+}
+
+// Servo position validation, the innermost hot-path call
+static void benchValidateServoPosition() {
+    const uint32_t N = 100000;
+    uint32_t start = esp_cpu_get_cycle_count();
+    for (uint32_t i = 0; i < N; i++) {
+        benchSink += validateServoPosition(SKULL_JAW_CHANNEL,
+                                           JAW_CLOSED + (i & 0xFF)) ? 1 : 0;
+    }
+    printResult("validate_servo", N, esp_cpu_get_cycle_count() - start);
+}
+
+// Fixed-point jaw oscillator sampling
+static void benchFixedOsc() {
+    const uint32_t N = 100000;
+    FixedOsc osc;
+    osc.setFrequency(384); // 1.5 Hz
+    osc.setAmplitude(256);
+    uint32_t start = esp_cpu_get_cycle_count();
+    for (uint32_t i = 0; i < N; i++) {
+        benchSink += (uint16_t)osc.next(10);
+    }
+    printResult("fixed_osc", N, esp_cpu_get_cycle_count() - start);
+}
+
+// Maestro frame staging: batch set + flush into the coalescing queue
+// (not serviced until the motion task starts, so nothing reaches the
+// UART during the measurement)
+static void benchMaestroStaging() {
+    const uint32_t N = 10000;
+    uint32_t start = esp_cpu_get_cycle_count();
+    for (uint32_t i = 0; i < N; i++) {
+        maestroBatch.setTarget(SKULL_PAN_CHANNEL, PAN_CENTER + (i & 0x3F));
+        maestroBatch.setTarget(SKULL_NOD_CHANNEL, NOD_CENTER + (i & 0x3F));
+        maestroBatch.setTarget(SKULL_JAW_CHANNEL, JAW_CLOSED + (i & 0x3F));
+        maestroBatch.flush();
+    }
+    printResult("maestro_stage", N, esp_cpu_get_cycle_count() - start);
+}
+
+// Redraw of a fixed screen area, exercising the render + flush path
+static void benchAreaRedraw() {
+    const uint32_t N = 50;
+    lv_area_t area = {60, 60, 180, 180};
+    uint32_t start = esp_cpu_get_cycle_count();
+    for (uint32_t i = 0; i < N; i++) {
+        lv_obj_invalidate_area(lv_screen_active(), &area);
+        lv_refr_now(lv_display_get_default());
+    }
+    printResult("area_redraw", N, esp_cpu_get_cycle_count() - start);
+}
+
+void runBenchmarks() {
+    Serial.println("bench,name,iterations,total_cycles,cycles_per_op");
+    benchEyeInterpolation();
+    benchKeyframeInterpolation();
+    benchValidateServoPosition();
+    benchFixedOsc();
+    benchMaestroStaging();
+    benchDynamicKeyframe();
+    benchAreaRedraw();
+    Serial.println("bench,done,0,0,0");
+}
@@ -0,0 +1,28 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+// =============================================================================
+// ON-DEVICE BENCHMARK SUITE
+// =============================================================================
+//
+// Deterministic microbenchmarks of the animation hot paths, for catching
+// regressions between firmware builds before rolling them to the fleet.
+// Build the sketch with -DRUN_BENCHMARKS (or define it below in config.h)
+// and the suite runs once at the end of setup(), printing one CSV line per
+// benchmark over Serial:
+//
+//     bench,<name>,<iterations>,<total_cycles>,<cycles_per_op>
+//
+// Normal operation continues after the suite finishes, so a benchmark build
+// is still a usable firmware.
+
+/**
+ * Runs the full benchmark suite and prints machine-readable CSV results
+ * over Serial. Must be called after setup() has initialized the display,
+ * the servo queue, and the config cache, but before the motion task is
+ * created: the suite stages targets it never services, and a concurrent
+ * motion tick would drain them to the Maestro and skew the cycle counts.
+ */
+void runBenchmarks();
+
+#endif // BENCHMARK_H
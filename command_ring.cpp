@@ -0,0 +1,51 @@
+#include "command_ring.h"
+
+#include <string.h>
+
+// =============================================================================
+// BLE COMMAND RING BUFFER IMPLEMENTATION
+// =============================================================================
+
+static const uint8_t RING_MASK = COMMAND_RING_SLOTS - 1;
+static_assert((COMMAND_RING_SLOTS & RING_MASK) == 0,
+              "COMMAND_RING_SLOTS must be a power of two");
+
+CommandRing::CommandRing() : head_(0), tail_(0), dropped_(0), pushed_(0) {
+}
+
+bool CommandRing::push(const char* data, size_t len) {
+    pushed_ = pushed_ + 1; // Arrival counter, even if the ring is full
+    uint8_t head = head_;
+    uint8_t next = (head + 1) & RING_MASK;
+    if (next == tail_) {
+        dropped_ = dropped_ + 1;
+        return false; // Full; drop rather than block the BLE task
+    }
+
+    if (len > MAX_COMMAND_LENGTH - 1) {
+        len = MAX_COMMAND_LENGTH - 1;
+    }
+    memcpy(slots_[head], data, len);
+    slots_[head][len] = '\0';
+    lengths_[head] = (uint8_t)len;
+
+    // Publish the slot only after its contents are written
+    head_ = next;
+    return true;
+}
+
+bool CommandRing::pop(char* out, uint8_t* lenOut) {
+    uint8_t tail = tail_;
+    if (tail == head_) {
+        return false; // Empty
+    }
+
+    memcpy(out, slots_[tail], lengths_[tail] + 1);
+    if (lenOut != nullptr) {
+        *lenOut = lengths_[tail];
+    }
+
+    // Release the slot only after its contents are copied out
+    tail_ = (tail + 1) & RING_MASK;
+    return true;
+}
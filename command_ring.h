@@ -0,0 +1,65 @@
+#ifndef COMMAND_RING_H
+#define COMMAND_RING_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "config.h"
+
+// =============================================================================
+// BLE COMMAND RING BUFFER
+// =============================================================================
+//
+// Lock-free single-producer/single-consumer ring between the BLE stack and
+// the motion task. onWrite() only copies the raw command bytes into a slot
+// (microseconds, no parsing, no UART traffic), and the motion task drains
+// and executes the commands on its own schedule. This keeps the radio stack
+// responsive when the controller streams servo/eye commands at 20+ Hz.
+
+// Number of buffered commands; must be a power of two for the index masks.
+// Eight slots absorbs a full connection-interval burst from the controller.
+const int COMMAND_RING_SLOTS = 8;
+
+class CommandRing {
+public:
+    CommandRing();
+
+    /**
+     * Copies a raw command into the ring. Producer side only (the BLE
+     * callback task). Never blocks.
+     * @param data Command bytes (need not be null-terminated)
+     * @param len Number of bytes; truncated to MAX_COMMAND_LENGTH-1
+     * @return false if the ring was full and the command was dropped
+     */
+    bool push(const char* data, size_t len);
+
+    /**
+     * Pops one command into a caller buffer. Consumer side only (the
+     * motion task).
+     * @param out Buffer of at least MAX_COMMAND_LENGTH bytes; receives a
+     *            null-terminated command
+     * @param lenOut Optional; receives the raw byte length (binary commands
+     *               may contain embedded NULs)
+     * @return false if the ring was empty
+     */
+    bool pop(char* out, uint8_t* lenOut = nullptr);
+
+    /** @return Number of commands dropped because the ring was full */
+    uint32_t dropped() const { return dropped_; }
+
+    /**
+     * @return Monotonic total of push attempts (including dropped ones).
+     *         The connection-parameter governor samples this to measure
+     *         command arrival rate.
+     */
+    uint32_t pushed() const { return pushed_; }
+
+private:
+    char slots_[COMMAND_RING_SLOTS][MAX_COMMAND_LENGTH];
+    uint8_t lengths_[COMMAND_RING_SLOTS];
+    volatile uint8_t head_; // Written only by the producer
+    volatile uint8_t tail_; // Written only by the consumer
+    volatile uint32_t dropped_;
+    volatile uint32_t pushed_;
+};
+
+#endif // COMMAND_RING_H
@@ -1,5 +1,6 @@
 #include "config.h"
 #include <pgmspace.h>
+#include <Preferences.h>
 
 // =============================================================================
 // GLOBAL VARIABLE DEFINITIONS
@@ -33,6 +34,29 @@ const DynamicModeConfig PROGMEM TALKING_DYNAMIC_CONFIG = {
     1500   // maxHoldDuration: 2 seconds
 };
 
+// =============================================================================
+// CHANNEL-INDEXED LOOKUP CACHE
+// =============================================================================
+
+// Channels are assigned densely from 0 and the config tables are authored in
+// channel order, so the channel number is itself the table index. Enforced at
+// compile time so a future channel remap can't silently break the O(1) path.
+static_assert(SKULL_PAN_CHANNEL == 0, "SERVO_RANGES[0] must be the pan channel");
+static_assert(SKULL_NOD_CHANNEL == 1, "SERVO_RANGES[1] must be the nod channel");
+static_assert(SKULL_JAW_CHANNEL == 2, "SERVO_RANGES[2] must be the jaw channel");
+
+// RAM copies of the PROGMEM tables, unpacked once at setup(). Every servo
+// write validates against these, so the hot path must not touch PROGMEM.
+static ServoRange servoRangeCache[NUM_SERVOS];
+static ServoMotionConfig servoMotionConfigCache[NUM_SERVO_MOTION_CONFIGS];
+static bool configCacheReady = false;
+
+void initServoConfigCache() {
+    memcpy_P(servoRangeCache, SERVO_RANGES, sizeof(servoRangeCache));
+    memcpy_P(servoMotionConfigCache, SERVO_MOTION_CONFIGS, sizeof(servoMotionConfigCache));
+    configCacheReady = true;
+}
+
 // =============================================================================
 // VALIDATION FUNCTION IMPLEMENTATIONS
 // =============================================================================
@@ -47,12 +71,8 @@ bool validateServoPosition(uint8_t channel, uint16_t position) {
 }
 
 bool validateEyePosition(int16_t h_offset, int16_t v_offset) {
-    // Define reasonable bounds for eye movement
-    const int16_t MAX_H_OFFSET = 60;  // Maximum horizontal offset
-    const int16_t MAX_V_OFFSET = 30;  // Maximum vertical offset
-
-    return (h_offset >= -MAX_H_OFFSET && h_offset <= MAX_H_OFFSET &&
-            v_offset >= -MAX_V_OFFSET && v_offset <= MAX_V_OFFSET);
+    return (h_offset >= -EYE_MAX_H_OFFSET && h_offset <= EYE_MAX_H_OFFSET &&
+            v_offset >= -EYE_MAX_V_OFFSET && v_offset <= EYE_MAX_V_OFFSET);
 }
 
 bool validateTiming(uint32_t duration_ms) {
@@ -64,21 +84,113 @@ bool validateTiming(uint32_t duration_ms) {
 }
 
 const ServoRange* getServoRange(uint8_t channel) {
-    for (int i = 0; i < NUM_SERVOS; i++) {
-        uint8_t channel_from_progmem = pgm_read_byte(&SERVO_RANGES[i].channel);
-        if (channel_from_progmem == channel) {
-            return &SERVO_RANGES[i]; // Return pointer to PROGMEM data
-        }
+    if (!configCacheReady || channel >= NUM_SERVOS) {
+        return nullptr; // Cache not initialized or unknown channel
     }
-    return nullptr; // Channel not found
+    return &servoRangeCache[channel];
 }
 
 const ServoMotionConfig* getServoMotionConfig(uint8_t channel) {
-    for (int i = 0; i < NUM_SERVO_MOTION_CONFIGS; i++) {
-        uint8_t channel_from_progmem = pgm_read_byte(&SERVO_MOTION_CONFIGS[i].channel);
-        if (channel_from_progmem == channel) {
-            return &SERVO_MOTION_CONFIGS[i]; // Return pointer to PROGMEM data
-        }
+    if (!configCacheReady || channel >= NUM_SERVO_MOTION_CONFIGS) {
+        return nullptr; // Cache not initialized or unknown channel
+    }
+    return &servoMotionConfigCache[channel];
+}
+
+// =============================================================================
+// NVS-BACKED CALIBRATION STORE
+// =============================================================================
+//
+// Every skull's linkage geometry differs slightly, so the PROGMEM tables are
+// only fleet-wide defaults. Per-unit calibration lives in NVS as one packed
+// blob and is overlaid onto the RAM caches at boot; the hot-path lookups
+// above never know the difference. Edits go through the `cal` BLE commands
+// and persist immediately.
+
+static const char* CAL_NVS_NAMESPACE = "skullcal";
+static const char* CAL_NVS_KEY = "servo";
+static const uint16_t CAL_BLOB_VERSION = 1;
+
+struct __attribute__((packed)) CalBlob {
+    uint16_t version;
+    struct __attribute__((packed)) {
+        uint16_t min;
+        uint16_t max;
+        uint16_t home;
+        uint16_t speed;
+        uint16_t acceleration;
+    } ch[NUM_SERVOS];
+};
+
+// Writes the current RAM caches to NVS as one blob
+static void persistCalibration() {
+    CalBlob blob;
+    blob.version = CAL_BLOB_VERSION;
+    for (int i = 0; i < NUM_SERVOS; i++) {
+        blob.ch[i].min = servoRangeCache[i].min;
+        blob.ch[i].max = servoRangeCache[i].max;
+        blob.ch[i].home = servoRangeCache[i].home;
+        blob.ch[i].speed = servoMotionConfigCache[i].speed;
+        blob.ch[i].acceleration = servoMotionConfigCache[i].acceleration;
     }
-    return nullptr; // Channel not found
+
+    Preferences prefs;
+    prefs.begin(CAL_NVS_NAMESPACE, false);
+    prefs.putBytes(CAL_NVS_KEY, &blob, sizeof(blob));
+    prefs.end();
+}
+
+void loadServoCalibration() {
+    Preferences prefs;
+    if (!prefs.begin(CAL_NVS_NAMESPACE, true)) {
+        return; // Namespace doesn't exist yet: factory defaults
+    }
+
+    CalBlob blob;
+    size_t got = prefs.getBytes(CAL_NVS_KEY, &blob, sizeof(blob));
+    prefs.end();
+
+    if (got != sizeof(blob) || blob.version != CAL_BLOB_VERSION) {
+        return; // Missing or stale-layout blob: keep PROGMEM defaults
+    }
+
+    for (int i = 0; i < NUM_SERVOS; i++) {
+        servoRangeCache[i].min = blob.ch[i].min;
+        servoRangeCache[i].max = blob.ch[i].max;
+        servoRangeCache[i].home = blob.ch[i].home;
+        servoMotionConfigCache[i].speed = blob.ch[i].speed;
+        servoMotionConfigCache[i].acceleration = blob.ch[i].acceleration;
+    }
+}
+
+bool setServoRangeCalibration(uint8_t channel, uint16_t min, uint16_t max,
+                              uint16_t home) {
+    if (!configCacheReady || channel >= NUM_SERVOS ||
+        min >= max || home < min || home > max) {
+        return false;
+    }
+    servoRangeCache[channel].min = min;
+    servoRangeCache[channel].max = max;
+    servoRangeCache[channel].home = home;
+    persistCalibration();
+    return true;
+}
+
+bool setServoMotionCalibration(uint8_t channel, uint16_t speed,
+                               uint16_t acceleration) {
+    if (!configCacheReady || channel >= NUM_SERVO_MOTION_CONFIGS) {
+        return false;
+    }
+    servoMotionConfigCache[channel].speed = speed;
+    servoMotionConfigCache[channel].acceleration = acceleration;
+    persistCalibration();
+    return true;
+}
+
+void clearServoCalibration() {
+    Preferences prefs;
+    prefs.begin(CAL_NVS_NAMESPACE, false);
+    prefs.remove(CAL_NVS_KEY);
+    prefs.end();
+    initServoConfigCache(); // Back to the PROGMEM defaults
 }
\ No newline at end of file
@@ -3,6 +3,15 @@
 
 #include <stdint.h>
 
+// =============================================================================
+// BUILD OPTIONS
+// =============================================================================
+
+// Uncomment (or pass -DRUN_BENCHMARKS) to run the on-device benchmark suite
+// once at the end of setup(), printing CSV results over Serial. See
+// benchmark.h for the output format.
+// #define RUN_BENCHMARKS
+
 // =============================================================================
 // HARDWARE CONFIGURATION
 // =============================================================================
@@ -10,6 +19,11 @@
 // Maestro servo controller pins
 static const int MAESTRO_TX_PIN = 21;
 
+// Maestro UART baud rate. The Maestro must be configured for fixed baud
+// (or autodetect) at this rate; it supports up to 250000. Higher baud cuts
+// per-keyframe serial latency proportionally.
+static const uint32_t MAESTRO_BAUD_RATE = 115200;
+
 // Servo channel assignments
 static const int SKULL_PAN_CHANNEL = 0;
 static const int SKULL_NOD_CHANNEL = 1;
@@ -42,6 +56,11 @@ const int EYE_CENTER_X = 120;
 const int EYE_CENTER_Y = 120;
 const int PUPIL_RADIUS = 30;
 
+// Maximum eye offsets accepted by validateEyePosition(); also the margin
+// the sclera gradient cache must cover so any legal eye pose can be blitted
+const int16_t EYE_MAX_H_OFFSET = 60;
+const int16_t EYE_MAX_V_OFFSET = 30;
+
 // Eye position offsets
 #define EYE_H_LEFT -40
 #define EYE_H_CENTER 0
@@ -58,6 +77,28 @@ const int PUPIL_RADIUS = 30;
 const int BLINK_INTERVAL_MIN_MS = 1000;
 const int BLINK_INTERVAL_MAX_MS = 5000;
 
+// How often to retry BLE advertising while no client is connected
+const uint32_t ADVERTISING_RETRY_INTERVAL_MS = 500;
+
+// How often the profiler report is dumped over Serial
+const uint32_t PROFILER_DUMP_INTERVAL_MS = 10000;
+
+// Upper bound on how long the render loop sleeps between iterations, so
+// cross-core UI events and pupil color changes stay responsive even when
+// the next scheduled deadline is far away
+const uint32_t UI_LOOP_MAX_SLEEP_MS = 10;
+
+// Idle governor (battery installations): with no client connected and no
+// sequence, talking, or envelope activity for the enter delay, the CPU
+// clock drops and both loops stretch their periods, waking only for the
+// blink and advertising events. The idle sleep cap bounds wake-to-
+// responsive latency when a client connects.
+const uint32_t IDLE_ENTER_DELAY_MS = 2000;
+const uint32_t IDLE_LOOP_MAX_SLEEP_MS = 100;
+const uint32_t IDLE_MOTION_TASK_PERIOD_MS = 50;
+const uint32_t CPU_FREQ_ACTIVE_MHZ = 240;
+const uint32_t CPU_FREQ_IDLE_MHZ = 80;
+
 // Servo motion parameters
 struct ServoMotionConfig {
     uint8_t channel;
@@ -68,6 +109,35 @@ struct ServoMotionConfig {
 extern const ServoMotionConfig SERVO_MOTION_CONFIGS[];
 #define NUM_SERVO_MOTION_CONFIGS 3
 
+// =============================================================================
+// FREERTOS TASK CONFIGURATION
+// =============================================================================
+
+// Core assignments: LVGL rendering stays on the core running the Arduino
+// loop (core 1 on ESP32); servo/motion logic gets the other core so a long
+// display flush can never stall a jaw update.
+const int RENDER_CORE = 1;
+const int MOTION_CORE = 0;
+
+// Fixed-rate period of the motion task (servo keyframes, jaw oscillator,
+// Maestro serial writes)
+const uint32_t MOTION_TASK_PERIOD_MS = 10;
+
+// Motion task stack size and priority
+const uint32_t MOTION_TASK_STACK_SIZE = 4096;
+const uint32_t MOTION_TASK_PRIORITY = 2;
+
+// Depth of the cross-core UI event queue (motion/BLE -> render)
+const int UI_EVENT_QUEUE_LENGTH = 16;
+
+// Loop budgets (see loop_budget.h): work time above these arms shedding of
+// optional work on the next iteration. The motion budget is half the tick
+// period so one heavy tick can't push servo writes past their deadline;
+// the render budget allows a full-frame gradient redraw but flags anything
+// worse.
+const uint32_t MOTION_TICK_BUDGET_US = 5000;
+const uint32_t RENDER_FRAME_BUDGET_US = 12000;
+
 // =============================================================================
 // DISPLAY CONFIGURATION
 // =============================================================================
@@ -95,6 +165,22 @@ struct ServoRange {
 extern const ServoRange SERVO_RANGES[];
 #define NUM_SERVOS 3
 
+// Servo arbitration (see servo_arbiter.h). Streaming sources renew their
+// claims every motion tick; the stream TTL is a few ticks of grace. Direct
+// commands hold their servo for a beat before playback reclaims it. The
+// crossfade spans ownership changes so handoffs never snap.
+const uint32_t ARBITER_STREAM_TTL_MS = 100;
+const uint32_t ARBITER_DIRECT_TTL_MS = 1000;
+const uint32_t ARBITER_DYNAMIC_TTL_MS = 30000;
+const uint32_t ARBITER_CROSSFADE_MS = 150;
+
+// Delta suppression deadband for servo writes, in quarter-microseconds.
+// A new target within this distance of the last transmitted target for the
+// same channel is not re-sent; this eliminates most UART traffic in talking
+// mode and reduces servo dither and heating. 4 quarter-us == 1 us of pulse
+// width, well below mechanical resolution.
+const uint16_t SERVO_DEADBAND_QUARTER_US = 4;
+
 // =============================================================================
 // OPERATION MODE CONFIGURATION
 // =============================================================================
@@ -131,6 +217,14 @@ const uint32_t TALK_SEGMENT_DURATION_MAX_MS = 1500; // Max duration of a "senten
 const uint32_t TALK_PAUSE_DURATION_MIN_MS = 100;    // Min pause between "words"
 const uint32_t TALK_PAUSE_DURATION_MAX_MS = 500;    // Max pause between "sentences"
 
+// Streamed envelope playback (see talk_envelope.h). The controller streams
+// jaw openness at this fixed rate; playback anchors its clock after the
+// prefill fills, trading that much latency for jitter absorption.
+const uint32_t ENVELOPE_SAMPLE_RATE_HZ = 50;
+const uint32_t ENVELOPE_SAMPLE_PERIOD_MS = 1000 / ENVELOPE_SAMPLE_RATE_HZ;
+const uint16_t ENVELOPE_PREFILL_SAMPLES = 4;        // 80 ms of buffered audio
+const uint32_t ENVELOPE_STARVE_TIMEOUT_MS = 200;    // Then fall back to sine
+
 // =============================================================================
 // BLUETOOTH CONFIGURATION
 // =============================================================================
@@ -142,6 +236,53 @@ const uint32_t TALK_PAUSE_DURATION_MAX_MS = 500;    // Max pause between "senten
 const int MAX_COMMAND_LENGTH = 64;
 const char COMMAND_DELIMITER = '\n';
 
+// Multi-skull timebase discipline (see synced_clock.h). Beacon errors above
+// the step threshold snap the offset; smaller ones slew by 1/2^shift per
+// beacon. A clock with no beacon for the timeout reports unsynced.
+const long SYNC_STEP_THRESHOLD_MS = 250;
+const int SYNC_EWMA_SHIFT = 3;              // Slew 1/8 of the error per beacon
+const uint32_t SYNC_VALID_TIMEOUT_MS = 10000;
+
+// Largest sequence file accepted over BLE upload (PSRAM staging buffer
+// cap); ~20,000 keyframes at the current record size
+const uint32_t SEQUENCE_UPLOAD_MAX_BYTES = 256 * 1024;
+
+// MTU requested from the central at connect; 517 is the BLE 5 maximum and
+// lets upload chunks carry ~500 payload bytes each
+const uint16_t BLE_MTU_REQUEST = 517;
+
+// Adaptive connection parameters (see conn_params.h). Intervals are in the
+// BLE spec's 1.25 ms units: fast is 7.5-15 ms for command bursts and the
+// envelope stream, slow is 100-120 ms for an idle link. A burst is
+// BLE_BURST_COMMAND_THRESHOLD command-ring pushes inside one window; the
+// link relaxes after BLE_CONN_IDLE_TIMEOUT_MS without a burst.
+const uint16_t BLE_CONN_INTERVAL_FAST_MIN_UNITS = 6;   // 7.5 ms
+const uint16_t BLE_CONN_INTERVAL_FAST_MAX_UNITS = 12;  // 15 ms
+const uint16_t BLE_CONN_INTERVAL_SLOW_MIN_UNITS = 80;  // 100 ms
+const uint16_t BLE_CONN_INTERVAL_SLOW_MAX_UNITS = 96;  // 120 ms
+const uint16_t BLE_CONN_SLAVE_LATENCY = 0;
+const uint16_t BLE_CONN_SUPERVISION_TIMEOUT_UNITS = 400; // 4 s (10 ms units)
+const uint32_t BLE_BURST_WINDOW_MS = 1000;
+const uint32_t BLE_BURST_COMMAND_THRESHOLD = 5;
+const uint32_t BLE_CONN_IDLE_TIMEOUT_MS = 5000;
+
+// OTA flash writing (see ota_update.h): chunk size and yield between
+// chunks trade update duration against the length of each cache stall
+// animation has to glide across; the task runs at render-loop priority
+const uint32_t OTA_WRITE_CHUNK_BYTES = 4096;
+const uint32_t OTA_WRITE_YIELD_MS = 20;
+const uint32_t OTA_TASK_STACK_SIZE = 4096;
+const uint32_t OTA_TASK_PRIORITY = 1;
+
+// Push telemetry gating (see telemetry.h): at most one notify per min
+// interval, at least one per heartbeat interval, and analog fields must
+// move past their thresholds to count as a change
+const uint32_t TELEMETRY_MIN_INTERVAL_MS = 100;
+const uint32_t TELEMETRY_HEARTBEAT_INTERVAL_MS = 1000;
+const uint16_t TELEMETRY_SERVO_THRESHOLD = 8;        // Quarter-microseconds
+const uint32_t TELEMETRY_HEAP_THRESHOLD_BYTES = 1024;
+const uint16_t TELEMETRY_TICK_THRESHOLD_US = 500;
+
 // =============================================================================
 // ANIMATION CONFIGURATION
 // =============================================================================
@@ -156,6 +297,15 @@ const uint32_t DEFAULT_BLINK_OPEN_DURATION = 150;
 const int EYELID_HEIGHT = 120;
 const int EYELID_WIDTH = 240;
 
+// Partial-invalidate eye renderer: with LV_GRAD_EXTEND_PAD the radial
+// gradient only changes meaningfully near the focal circle, so each
+// animation tick invalidates the focal neighborhood (circle radius plus
+// this pad) at the old and new positions instead of the whole object.
+const int EYE_DIRTY_REGION_PAD = 24;
+
+// Focal jumps larger than this per tick fall back to a full-object redraw
+const int EYE_DIRTY_FULL_REDRAW_THRESHOLD = 48;
+
 // =============================================================================
 // VALIDATION FUNCTIONS
 // =============================================================================
@@ -184,16 +334,61 @@ bool validateEyePosition(int16_t h_offset, int16_t v_offset);
 bool validateTiming(uint32_t duration_ms);
 
 /**
- * Gets the servo range configuration for a given channel
+ * Unpacks SERVO_RANGES and SERVO_MOTION_CONFIGS from PROGMEM into RAM
+ * caches indexed directly by channel. Must be called once in setup()
+ * before any lookup below.
+ */
+void initServoConfigCache();
+
+/**
+ * Overlays per-unit calibration from NVS onto the RAM caches. Channels
+ * without stored calibration keep the PROGMEM defaults, so one firmware
+ * image serves every skull in the fleet. Call once in setup(), after
+ * initServoConfigCache().
+ */
+void loadServoCalibration();
+
+/**
+ * Updates a channel's range calibration in RAM and persists it to NVS.
+ * @param channel The servo channel
+ * @param min Minimum position in quarter-microseconds
+ * @param max Maximum position in quarter-microseconds
+ * @param home Home position; must lie within [min, max]
+ * @return false if the channel or bounds are invalid
+ */
+bool setServoRangeCalibration(uint8_t channel, uint16_t min, uint16_t max,
+                              uint16_t home);
+
+/**
+ * Updates a channel's speed/acceleration calibration in RAM and persists
+ * it to NVS. Values use Maestro units (see ServoMotionConfig).
+ * @param channel The servo channel
+ * @param speed Speed limit (0 = unlimited)
+ * @param acceleration Acceleration limit (0 = unlimited)
+ * @return false if the channel is invalid
+ */
+bool setServoMotionCalibration(uint8_t channel, uint16_t speed,
+                               uint16_t acceleration);
+
+/**
+ * Erases stored calibration and restores the PROGMEM defaults in RAM.
+ */
+void clearServoCalibration();
+
+/**
+ * Gets the servo range configuration for a given channel.
+ * O(1): a bounds check plus an array index into the RAM cache, with no
+ * PROGMEM reads — this sits on the hot path of every servo write.
  * @param channel The servo channel
- * @return Pointer to ServoRange struct, or nullptr if channel not found
+ * @return Pointer to ServoRange struct in RAM, or nullptr if channel not found
  */
 const ServoRange* getServoRange(uint8_t channel);
 
 /**
- * Gets the servo motion configuration for a given channel
+ * Gets the servo motion configuration for a given channel.
+ * O(1) RAM lookup, same scheme as getServoRange().
  * @param channel The servo channel
- * @return Pointer to ServoMotionConfig struct, or nullptr if channel not found
+ * @return Pointer to ServoMotionConfig struct in RAM, or nullptr if channel not found
  */
 const ServoMotionConfig* getServoMotionConfig(uint8_t channel);
 
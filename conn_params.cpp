@@ -0,0 +1,86 @@
+#include "conn_params.h"
+
+#include <Arduino.h>
+#include <string.h>
+
+// =============================================================================
+// ADAPTIVE BLE CONNECTION PARAMETERS IMPLEMENTATION
+// =============================================================================
+
+ConnParamGovernor::ConnParamGovernor()
+    : server_(nullptr), connected_(false), windowBase_(0),
+      windowStartMs_(0), lastActivityMs_(0), requestedUnits_(0) {
+    memset(peer_, 0, sizeof(peer_));
+}
+
+void ConnParamGovernor::onConnect(BLEServer* server, const uint8_t* peerAddr) {
+    server_ = server;
+    memcpy(peer_, peerAddr, sizeof(peer_));
+    connected_ = true;
+
+    // Treat the connect itself as activity: interactive sessions start
+    // with commands, and if not, the idle timeout relaxes the link anyway
+    unsigned long now = millis();
+    lastActivityMs_ = now;
+    windowStartMs_ = now;
+    requestedUnits_ = 0;
+    request(true, now);
+}
+
+void ConnParamGovernor::onDisconnect() {
+    connected_ = false;
+    requestedUnits_ = 0;
+}
+
+void ConnParamGovernor::service(unsigned long now, uint32_t commandsPushed,
+                                bool streamActive) {
+    if (!connected_) {
+        return;
+    }
+
+    if (streamActive) {
+        lastActivityMs_ = now;
+    }
+
+    // Command rate over a rolling window of the ring's push counter. The
+    // threshold marks a burst (streamed eye/servo traffic), not the odd
+    // one-shot command, which is happy at any interval.
+    uint32_t pushes = commandsPushed - windowBase_;
+    if (pushes >= BLE_BURST_COMMAND_THRESHOLD) {
+        lastActivityMs_ = now;
+        windowBase_ = commandsPushed;
+        windowStartMs_ = now;
+    } else if (now - windowStartMs_ >= BLE_BURST_WINDOW_MS) {
+        windowBase_ = commandsPushed;
+        windowStartMs_ = now;
+    }
+
+    bool wantFast = (now - lastActivityMs_) <= BLE_CONN_IDLE_TIMEOUT_MS;
+    uint16_t wantUnits = wantFast ? BLE_CONN_INTERVAL_FAST_MIN_UNITS
+                                  : BLE_CONN_INTERVAL_SLOW_MIN_UNITS;
+    if (wantUnits != requestedUnits_) {
+        request(wantFast, now);
+    }
+}
+
+void ConnParamGovernor::request(bool fast, unsigned long now) {
+    (void)now;
+    if (server_ == nullptr) {
+        return;
+    }
+    uint16_t minUnits = fast ? BLE_CONN_INTERVAL_FAST_MIN_UNITS
+                             : BLE_CONN_INTERVAL_SLOW_MIN_UNITS;
+    uint16_t maxUnits = fast ? BLE_CONN_INTERVAL_FAST_MAX_UNITS
+                             : BLE_CONN_INTERVAL_SLOW_MAX_UNITS;
+    // A min/max range rather than a point value: the central picks inside
+    // it, which makes acceptance much more likely than demanding one exact
+    // interval
+    server_->updateConnParams(peer_, minUnits, maxUnits,
+                              BLE_CONN_SLAVE_LATENCY,
+                              BLE_CONN_SUPERVISION_TIMEOUT_UNITS);
+    requestedUnits_ = minUnits;
+
+    Serial.print("Conn params requested: ");
+    Serial.print(minUnits * 125 / 100);
+    Serial.println(" ms min interval");
+}
@@ -0,0 +1,74 @@
+#ifndef CONN_PARAMS_H
+#define CONN_PARAMS_H
+
+#include <stdint.h>
+#include <BLEServer.h>
+#include "config.h"
+
+// =============================================================================
+// ADAPTIVE BLE CONNECTION PARAMETERS
+// =============================================================================
+//
+// The connection interval is the floor under command latency: a central
+// that settles on 30-50 ms adds that much to every streamed `eye`/`servo`
+// command and to the speech-to-jaw path. This governor watches the command
+// ring's arrival rate (plus the envelope stream) and renegotiates:
+//
+//   - burst detected (or fresh connect): request a 7.5-15 ms interval so
+//     interactive streams see the radio, not the schedule
+//   - idle for BLE_CONN_IDLE_TIMEOUT_MS: relax to 100-120 ms, saving radio
+//     and power while the skull runs autonomously
+//
+// Requests go through BLEServer::updateConnParams (an L2CAP parameter
+// update the central may still reject); only transitions are requested, so
+// a steady state costs no airtime. The most recent request is surfaced in
+// the telemetry packet so the controller can see what the link is doing.
+
+class ConnParamGovernor {
+public:
+    ConnParamGovernor();
+
+    /**
+     * Captures the peer and requests the fast interval (a fresh connect
+     * is almost always the start of an interactive session).
+     * Call from the server's onConnect callback.
+     * @param server The BLE server (for updateConnParams)
+     * @param peerAddr The central's 6-byte address from the connect event
+     */
+    void onConnect(BLEServer* server, const uint8_t* peerAddr);
+
+    /** Forgets the peer. Call from the server's onDisconnect callback. */
+    void onDisconnect();
+
+    /**
+     * Periodic burst/idle decision. Call from the render loop.
+     * @param now Current time in milliseconds
+     * @param commandsPushed Monotonic total of commands pushed into the
+     *        command ring (see CommandRing::pushed())
+     * @param streamActive true while the envelope stream is playing; it
+     *        needs the fast interval as much as a command burst does
+     */
+    void service(unsigned long now, uint32_t commandsPushed, bool streamActive);
+
+    /**
+     * @return The minimum interval most recently requested, in 1.25 ms
+     *         units (0 before the first request). Read by telemetry.
+     */
+    uint16_t requestedIntervalUnits() const { return requestedUnits_; }
+
+private:
+    void request(bool fast, unsigned long now);
+
+    BLEServer* server_;
+    uint8_t peer_[6];
+    bool connected_;
+
+    // Command-rate window over the ring's monotonic push counter
+    uint32_t windowBase_;
+    unsigned long windowStartMs_;
+    unsigned long lastActivityMs_;
+
+    volatile uint16_t requestedUnits_; // Written here, read by telemetry
+};
+
+#endif // CONN_PARAMS_H
@@ -0,0 +1,126 @@
+#include "display_flush.h"
+#include "config.h"
+#include "profiler.h"
+
+#include <TFT_eSPI.h>
+#include <esp_heap_caps.h>
+#include <string.h>
+
+// =============================================================================
+// DMA DISPLAY FLUSH IMPLEMENTATION
+// =============================================================================
+
+static TFT_eSPI tft = TFT_eSPI(TFT_HOR_RES, TFT_VER_RES);
+
+// Two ping-pong buffers in internal RAM (static allocation), which is
+// required for the SPI DMA engine to read from them. In the partial
+// strategy they are LVGL's draw buffers; in the PSRAM strategy they serve
+// as DMA bounce buffers between the full frame and the panel.
+static uint32_t draw_buf_1[DRAW_BUF_SIZE / 4];
+static uint32_t draw_buf_2[DRAW_BUF_SIZE / 4];
+
+// Full-frame buffer size in bytes for the PSRAM strategy
+#define FULL_FRAME_BUF_SIZE (TFT_HOR_RES * TFT_VER_RES * (LV_COLOR_DEPTH / 8))
+
+void my_disp_flush(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map)
+{
+    ScopedProfile prof(PROF_DISP_FLUSH);
+
+    uint32_t w = lv_area_get_width(area);
+    uint32_t h = lv_area_get_height(area);
+
+    // Wait for the previous DMA transfer before touching the bus again.
+    // While that transfer was in flight, LVGL was already rendering the
+    // next area into the other ping-pong buffer.
+    tft.dmaWait();
+
+    tft.setAddrWindow(area->x1, area->y1, w, h);
+    tft.pushPixelsDMA((uint16_t *)px_map, w * h);
+
+    // Tell LVGL it can start rendering the next area immediately. The
+    // buffer being transferred stays untouched because LVGL alternates
+    // buffers, and the dmaWait() above protects the bus.
+    lv_display_flush_ready(disp);
+}
+
+// Flush callback for the full-frame PSRAM strategy. In DIRECT mode LVGL
+// renders dirty areas straight into the frame buffer and hands us the area
+// with px_map pointing at its top-left pixel, rows TFT_HOR_RES apart. The
+// DMA engine cannot read PSRAM, so bands of rows bounce through the two
+// internal buffers: while band N streams to the panel, the CPU copies band
+// N+1 out of PSRAM. One address-window setup covers the whole area.
+static void my_disp_flush_direct(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map)
+{
+    ScopedProfile prof(PROF_DISP_FLUSH);
+
+    uint32_t w = lv_area_get_width(area);
+    uint32_t h = lv_area_get_height(area);
+    const uint16_t *src = (const uint16_t *)px_map;
+
+    uint32_t rowsPerBand = (DRAW_BUF_SIZE / 2) / w;
+    if (rowsPerBand == 0) {
+        rowsPerBand = 1;
+    }
+
+    tft.dmaWait();
+    tft.setAddrWindow(area->x1, area->y1, w, h);
+
+    bool useFirst = true;
+    for (uint32_t y = 0; y < h; y += rowsPerBand) {
+        uint32_t rows = h - y;
+        if (rows > rowsPerBand) {
+            rows = rowsPerBand;
+        }
+
+        uint16_t *bounce = useFirst ? (uint16_t *)draw_buf_1
+                                    : (uint16_t *)draw_buf_2;
+        for (uint32_t r = 0; r < rows; r++) {
+            memcpy(bounce + r * w, src + (y + r) * TFT_HOR_RES, w * 2);
+        }
+
+        tft.dmaWait(); // The bounce buffer may still be streaming
+        tft.pushPixelsDMA(bounce, w * rows);
+        useFirst = !useFirst;
+    }
+
+    lv_display_flush_ready(disp);
+}
+
+lv_display_t * displayInit(void)
+{
+    tft.init();
+    tft.setSwapBytes(true); // RGB565 byte order expected by the panel
+    tft.initDMA();
+
+    // Keep the SPI transaction open for the lifetime of the display so the
+    // flush callback never pays transaction setup cost per area.
+    tft.startWrite();
+
+    lv_display_t *disp = lv_display_create(TFT_HOR_RES, TFT_VER_RES);
+    lv_display_set_rotation(disp, TFT_ROTATION);
+
+    // Buffer strategy: a full frame in PSRAM when the module has it,
+    // otherwise the internal-RAM partial buffers
+    uint8_t *frame = nullptr;
+    if (psramFound()) {
+        frame = (uint8_t *)heap_caps_malloc(FULL_FRAME_BUF_SIZE, MALLOC_CAP_SPIRAM);
+    }
+
+    if (frame != nullptr) {
+        // Single full-frame buffer: DIRECT mode renders only dirty areas,
+        // keeps the whole image resident, and flushes each dirty area in
+        // one address window. No second buffer, so LVGL has nothing to
+        // keep in sync and the flush reads the same memory it rendered to.
+        lv_display_set_flush_cb(disp, my_disp_flush_direct);
+        lv_display_set_buffers(disp, frame, NULL, FULL_FRAME_BUF_SIZE,
+                               LV_DISPLAY_RENDER_MODE_DIRECT);
+        Serial.println("Display: full-frame PSRAM buffer (direct mode)");
+    } else {
+        lv_display_set_flush_cb(disp, my_disp_flush);
+        lv_display_set_buffers(disp, draw_buf_1, draw_buf_2, sizeof(draw_buf_1),
+                               LV_DISPLAY_RENDER_MODE_PARTIAL);
+        Serial.println("Display: partial internal-RAM buffers");
+    }
+
+    return disp;
+}
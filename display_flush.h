@@ -0,0 +1,39 @@
+#ifndef DISPLAY_FLUSH_H
+#define DISPLAY_FLUSH_H
+
+#include <lvgl.h>
+
+// =============================================================================
+// DMA DISPLAY FLUSH PATH
+// =============================================================================
+//
+// Owns the TFT_eSPI instance and the LVGL draw buffers, picking a buffer
+// strategy at startup:
+//
+//   - With PSRAM: one full-frame buffer in PSRAM and
+//     LV_DISPLAY_RENDER_MODE_DIRECT. A full-screen redraw becomes a single
+//     address-window setup instead of ten, and pixels stream to the panel
+//     through two internal-RAM bounce buffers (the SPI DMA engine cannot
+//     read PSRAM directly) so the CPU copies band N+1 while band N is in
+//     flight.
+//
+//   - Without PSRAM: the original two internal-RAM ping-pong partial
+//     buffers, where LVGL renders the next dirty area while the previous
+//     one is still streaming.
+
+/**
+ * Initializes the TFT panel, the SPI DMA engine, and the LVGL display,
+ * selecting the render mode for the detected memory configuration. Call
+ * once from setup() after lv_init().
+ * @return The created LVGL display
+ */
+lv_display_t * displayInit(void);
+
+/**
+ * LVGL flush callback for the partial (internal-RAM) strategy. Queues the
+ * rendered area for DMA transfer and returns without waiting for it to
+ * complete.
+ */
+void my_disp_flush(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map);
+
+#endif // DISPLAY_FLUSH_H
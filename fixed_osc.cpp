@@ -0,0 +1,87 @@
+#include "fixed_osc.h"
+
+#include <pgmspace.h>
+
+// =============================================================================
+// FIXED-POINT SINE OSCILLATOR IMPLEMENTATION
+// =============================================================================
+
+// Quarter-wave sine table: SINE_LUT[i] == round(sin(i * pi/2 / 256) * 256).
+// 257 entries so the quarter-wave endpoint (sin(pi/2) == 1.0) is exact.
+static const uint16_t SINE_LUT[257] PROGMEM = {
+      0,   2,   3,   5,   6,   8,   9,  11,
+     13,  14,  16,  17,  19,  20,  22,  24,
+     25,  27,  28,  30,  31,  33,  34,  36,
+     38,  39,  41,  42,  44,  45,  47,  48,
+     50,  51,  53,  55,  56,  58,  59,  61,
+     62,  64,  65,  67,  68,  70,  71,  73,
+     74,  76,  77,  79,  80,  82,  83,  85,
+     86,  88,  89,  91,  92,  94,  95,  97,
+     98,  99, 101, 102, 104, 105, 107, 108,
+    109, 111, 112, 114, 115, 117, 118, 119,
+    121, 122, 123, 125, 126, 128, 129, 130,
+    132, 133, 134, 136, 137, 138, 140, 141,
+    142, 144, 145, 146, 147, 149, 150, 151,
+    152, 154, 155, 156, 157, 159, 160, 161,
+    162, 164, 165, 166, 167, 168, 170, 171,
+    172, 173, 174, 175, 177, 178, 179, 180,
+    181, 182, 183, 184, 185, 186, 188, 189,
+    190, 191, 192, 193, 194, 195, 196, 197,
+    198, 199, 200, 201, 202, 203, 204, 205,
+    206, 207, 207, 208, 209, 210, 211, 212,
+    213, 214, 215, 215, 216, 217, 218, 219,
+    220, 220, 221, 222, 223, 224, 224, 225,
+    226, 227, 227, 228, 229, 229, 230, 231,
+    231, 232, 233, 233, 234, 235, 235, 236,
+    237, 237, 238, 238, 239, 239, 240, 241,
+    241, 242, 242, 243, 243, 244, 244, 245,
+    245, 245, 246, 246, 247, 247, 248, 248,
+    248, 249, 249, 249, 250, 250, 250, 251,
+    251, 251, 252, 252, 252, 252, 253, 253,
+    253, 253, 254, 254, 254, 254, 254, 255,
+    255, 255, 255, 255, 255, 255, 256, 256,
+    256, 256, 256, 256, 256, 256, 256, 256,
+    256
+};
+
+// Phase step per millisecond for a 1/256 Hz frequency unit:
+// 2^32 / 1000 / 256 == 16777.216, rounded. The 0.001% error is far below
+// the jitter of the millis() timebase.
+static const uint32_t PHASE_STEP_PER_FREQ_UNIT = 16777;
+
+FixedOsc::FixedOsc() : phase_(0), phaseStepPerMs_(0), amplitude_(256) {
+}
+
+void FixedOsc::setFrequency(uint16_t freq_hz_q8_8) {
+    phaseStepPerMs_ = (uint32_t)freq_hz_q8_8 * PHASE_STEP_PER_FREQ_UNIT;
+}
+
+void FixedOsc::setAmplitude(uint16_t amp_q8_8) {
+    amplitude_ = amp_q8_8;
+}
+
+void FixedOsc::resetPhase() {
+    phase_ = 0;
+}
+
+int16_t FixedOsc::sineQ8_8(uint16_t angle) {
+    uint8_t quadrant = (angle >> 8) & 0x03;
+    uint16_t idx = angle & 0xFF;
+
+    switch (quadrant) {
+        case 0: return (int16_t)pgm_read_word(&SINE_LUT[idx]);
+        case 1: return (int16_t)pgm_read_word(&SINE_LUT[256 - idx]);
+        case 2: return -(int16_t)pgm_read_word(&SINE_LUT[idx]);
+        default: return -(int16_t)pgm_read_word(&SINE_LUT[256 - idx]);
+    }
+}
+
+int16_t FixedOsc::next(uint32_t dt_ms) {
+    phase_ += phaseStepPerMs_ * dt_ms;
+
+    // Top 10 bits of the accumulator select one of 1024 angle steps
+    int16_t s = sineQ8_8((uint16_t)(phase_ >> 22));
+
+    // Apply Q8.8 amplitude
+    return (int16_t)(((int32_t)s * amplitude_) >> 8);
+}
@@ -0,0 +1,61 @@
+#ifndef FIXED_OSC_H
+#define FIXED_OSC_H
+
+#include <stdint.h>
+
+// =============================================================================
+// FIXED-POINT SINE OSCILLATOR
+// =============================================================================
+//
+// Integer phase-accumulator oscillator backed by a 256-entry quarter-wave
+// sine LUT in PROGMEM. Replaces the per-loop double-precision sin() in the
+// jaw movement path; frequency and amplitude are Q8.8 fixed point (256 ==
+// 1.0). Frequency changes preserve phase, so a talk-segment speed change
+// never makes the jaw jump.
+//
+// Reusable: the dynamic mode (or any other animation source) can run its
+// own instance.
+
+class FixedOsc {
+public:
+    FixedOsc();
+
+    /**
+     * Sets the oscillator frequency.
+     * @param freq_hz_q8_8 Frequency in Hz, Q8.8 (e.g. 384 == 1.5 Hz)
+     */
+    void setFrequency(uint16_t freq_hz_q8_8);
+
+    /**
+     * Sets the output amplitude scale.
+     * @param amp_q8_8 Amplitude in Q8.8, where 256 == full scale
+     */
+    void setAmplitude(uint16_t amp_q8_8);
+
+    /**
+     * Resets the phase accumulator to zero (output starts at 0, rising).
+     */
+    void resetPhase();
+
+    /**
+     * Advances the oscillator and samples it.
+     * @param dt_ms Milliseconds elapsed since the previous call
+     * @return Amplitude-scaled sine value in Q8.8, range [-256, 256]
+     */
+    int16_t next(uint32_t dt_ms);
+
+    /**
+     * Evaluates sine from the quarter-wave LUT without touching any
+     * oscillator state.
+     * @param angle Angle in 1/1024ths of a full cycle (0..1023)
+     * @return Sine value in Q8.8, range [-256, 256]
+     */
+    static int16_t sineQ8_8(uint16_t angle);
+
+private:
+    uint32_t phase_;         // Full cycle == 2^32
+    uint32_t phaseStepPerMs_;
+    uint16_t amplitude_;     // Q8.8
+};
+
+#endif // FIXED_OSC_H
@@ -0,0 +1,21 @@
+#include "loop_budget.h"
+
+// =============================================================================
+// LOOP BUDGET MANAGER IMPLEMENTATION
+// =============================================================================
+
+LoopBudget::LoopBudget(uint32_t budgetUs)
+    : budgetUs_(budgetUs), shedArmed_(false), overruns_(0), sheds_(0) {
+}
+
+void LoopBudget::recordWork(uint32_t workUs) {
+    if (workUs > budgetUs_) {
+        overruns_++;
+        shedArmed_ = true;
+    } else {
+        // One under-budget iteration disarms shedding; a sustained overload
+        // alternates full and degraded iterations instead of degrading
+        // permanently
+        shedArmed_ = false;
+    }
+}
@@ -0,0 +1,55 @@
+#ifndef LOOP_BUDGET_H
+#define LOOP_BUDGET_H
+
+#include <stdint.h>
+
+// =============================================================================
+// LOOP BUDGET MANAGER
+// =============================================================================
+//
+// Graceful degradation for overloaded iterations. Each loop owns one
+// LoopBudget; it records how long the iteration's work took, and when an
+// iteration blows its budget the next one sheds its optional work --
+// scripted in-between interpolation and telemetry on the motion task,
+// the LVGL frame on the render loop. Servo and jaw writes always run.
+// Overruns and sheds are counted and surfaced through the stats command,
+// so a show that degraded is visible afterwards instead of reading as
+// random stutter.
+
+class LoopBudget {
+public:
+    /**
+     * @param budgetUs Work-time budget for one iteration, in microseconds
+     */
+    explicit LoopBudget(uint32_t budgetUs);
+
+    /**
+     * Records the work time of the iteration that just finished. Exceeding
+     * the budget arms shedding for the next iteration.
+     * @param workUs Measured work time in microseconds
+     */
+    void recordWork(uint32_t workUs);
+
+    /**
+     * @return true if the previous iteration overran and this one should
+     *         shed its optional work
+     */
+    bool shouldShed() const { return shedArmed_; }
+
+    /** Counts one unit of optional work actually shed. */
+    void noteShed() { sheds_++; }
+
+    /** @return Iterations that exceeded the budget */
+    uint32_t overruns() const { return overruns_; }
+
+    /** @return Times optional work was shed in response */
+    uint32_t sheds() const { return sheds_; }
+
+private:
+    uint32_t budgetUs_;
+    bool shedArmed_;
+    uint32_t overruns_;
+    uint32_t sheds_;
+};
+
+#endif // LOOP_BUDGET_H
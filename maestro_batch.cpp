@@ -0,0 +1,29 @@
+#include "maestro_batch.h"
+
+// =============================================================================
+// BATCHED MAESTRO COMMAND WRITER IMPLEMENTATION
+// =============================================================================
+
+MaestroBatch::MaestroBatch(ServoTxQueue &txQueue) : txQueue_(txQueue) {
+    for (int i = 0; i < NUM_SERVOS; i++) {
+        targets_[i] = 0;
+        pending_[i] = false;
+    }
+}
+
+void MaestroBatch::setTarget(uint8_t channel, uint16_t target) {
+    if (channel >= NUM_SERVOS) {
+        return;
+    }
+    targets_[channel] = target;
+    pending_[channel] = true;
+}
+
+void MaestroBatch::flush() {
+    for (int i = 0; i < NUM_SERVOS; i++) {
+        if (pending_[i]) {
+            txQueue_.enqueueTarget(i, targets_[i]);
+            pending_[i] = false;
+        }
+    }
+}
@@ -0,0 +1,42 @@
+#ifndef MAESTRO_BATCH_H
+#define MAESTRO_BATCH_H
+
+#include <stdint.h>
+#include "config.h"
+#include "servo_tx_queue.h"
+
+// =============================================================================
+// BATCHED MAESTRO COMMAND WRITER
+// =============================================================================
+//
+// Accumulates per-loop servo targets so all axes of a keyframe are handed to
+// the TX queue in one go. The queue emits contiguous channels as a single
+// Pololu multi-target frame, so pan/nod/jaw land on the same servo period
+// instead of milliseconds apart.
+
+class MaestroBatch {
+public:
+    explicit MaestroBatch(ServoTxQueue &txQueue);
+
+    /**
+     * Stages a target for a channel. Nothing reaches the TX queue until
+     * flush() is called; staging the same channel twice keeps the newest
+     * value.
+     * @param channel The servo channel (0 .. NUM_SERVOS-1)
+     * @param target Target position in quarter-microseconds
+     */
+    void setTarget(uint8_t channel, uint16_t target);
+
+    /**
+     * Hands all staged targets to the TX queue together and clears the
+     * batch. The queue coalesces and frames them for transmission.
+     */
+    void flush();
+
+private:
+    ServoTxQueue &txQueue_;
+    uint16_t targets_[NUM_SERVOS];
+    bool pending_[NUM_SERVOS];
+};
+
+#endif // MAESTRO_BATCH_H
@@ -0,0 +1,285 @@
+#include "motion_modes.h"
+
+#include <Arduino.h>
+#include <pgmspace.h>
+#include <string.h>
+
+#include "sequence_engine.h"
+#include "servo_arbiter.h"
+#include "talk_envelope.h"
+#include "synced_clock.h"
+#include "fixed_osc.h"
+#include "scheduler.h"
+#include "loop_budget.h"
+#include "profiler.h"
+#include "ui_events.h"
+
+// =============================================================================
+// MOTION MODE HANDLER IMPLEMENTATION
+// =============================================================================
+
+// Collaborating objects, defined by the sketch (or by sim/main.cpp)
+extern SequenceEngine sequenceEngine;
+extern ServoArbiter servoArbiter;
+extern TalkEnvelope talkEnvelope;
+extern SyncedClock syncedClock;
+extern EventScheduler motionScheduler;
+extern ScheduledEvent dynamicMoveEvent;
+extern LoopBudget motionBudget;
+
+// Operation mode configuration
+volatile OperationMode currentMode = OperationMode::DYNAMIC;
+
+// Dynamic mode state variables
+DynamicModeConfig dynamicConfig = DEFAULT_DYNAMIC_CONFIG;
+
+// Shared between the BLE task, the motion task, and the render loop
+volatile bool sequencePaused = true;
+
+// Talking mode state variables
+volatile unsigned long talkingStartTime = 0;
+static uint16_t currentJawSpeed = 0;     // Q8.8 Hz (256 == 1.0 Hz)
+static uint16_t currentJawAmplitude = 0; // Q8.8 scale (256 == 100%)
+static FixedOsc jawOsc;
+unsigned long talkSegmentStartTime = 0;
+uint32_t currentTalkSegmentDuration = 0;
+
+// for tracking playback
+unsigned long sequenceStartTime = 0;
+// Offset into the sequence captured at pause time, replayed on resume
+uint32_t sequencePausedOffset = 0;
+// Interpolation segment origin: the most recently fired keyframe
+static Keyframe interpFromKeyframe;
+bool interpValid = false;
+
+// Helper functions for dynamic mode
+static inline uint16_t max(uint16_t a, uint16_t b) { return (a > b) ? a : b; }
+static inline uint16_t min(uint16_t a, uint16_t b) { return (a < b) ? a : b; }
+
+void handleScriptedMode(unsigned long currentTime, bool shedInterpolation) {
+    ScopedProfile prof(PROF_SCRIPTED_MODE);
+
+    // Skip processing if sequence is paused
+    if (sequencePaused) {
+        return;
+    }
+
+    // The whole scripted timeline runs in show time: identical to local
+    // millis() on a lone skull, disciplined by sync beacons in a group so
+    // all skulls compute the same sequenceTime despite crystal drift
+    unsigned long showNow = syncedClock.now(currentTime);
+
+    // (Re)anchor the timeline on first run or after resume. seekTo is a
+    // binary search on startTime, so resuming mid-show is O(log n).
+    if (sequenceStartTime == 0) {
+      sequenceStartTime = showNow - sequencePausedOffset;
+      sequenceEngine.seekTo(sequencePausedOffset);
+      sequencePausedOffset = 0;
+      interpValid = false;
+    }
+
+    // An armed shared downbeat (`start <showTimeMs>`) may still be in the
+    // future; hold position until show time reaches it
+    if ((long)(showNow - sequenceStartTime) < 0) {
+        return;
+    }
+
+    unsigned long sequenceTime = showNow - sequenceStartTime;
+
+    // Fire any due keyframes: each becomes the new interpolation origin and
+    // its exact pose goes out so keyframe times are always hit precisely
+    Keyframe currentKeyframe;
+    while (sequenceEngine.peek(&currentKeyframe) && sequenceTime >= currentKeyframe.startTime) {
+        // Claim the target positions for the current keyframe; the
+        // arbiter emits all axes together at the end of the tick. A
+        // validated source (compile-time for the built-in sequence,
+        // load-time for files) skips the per-servo runtime check.
+        bool preValidated = sequenceEngine.validated();
+        for (int i = 0; i < NUM_SERVOS; i++) {
+            uint8_t channel = getServoRange(i)->channel;
+            uint16_t position = currentKeyframe.positions[i];
+
+            if (preValidated || validateServoPosition(channel, position)) {
+                servoArbiter.setTarget(ARB_SRC_SCRIPTED, channel, position);
+            }
+        }
+
+        interpFromKeyframe = currentKeyframe;
+        interpValid = true;
+
+        // Animate the eye to the new position
+        uint32_t duration = DEFAULT_EYE_ANIMATION_DURATION;
+        uint32_t nextStartTime;
+        if (sequenceEngine.startTimeAt(sequenceEngine.index() + 1, &nextStartTime)) {
+            duration = nextStartTime - currentKeyframe.startTime;
+        }
+        // Validate eye position before animating
+        if (validateEyePosition(currentKeyframe.eye_h_pos, currentKeyframe.eye_v_pos) &&
+            validateTiming(duration)) {
+            requestEyeMove(currentKeyframe.eye_h_pos, currentKeyframe.eye_v_pos, duration);
+        }
+
+        sequenceEngine.advance();
+    }
+
+    // Between keyframes, stream eased in-between servo positions every
+    // motion tick instead of leaving smoothing to the Maestro speed/accel
+    // limits. Authored sequences can be much sparser for the same motion.
+    // This is the tick's optional work: when the budget manager says the
+    // previous tick overran, skip one in-between (the Maestro glides) so
+    // keyframe firing and jaw writes stay on time.
+    if (shedInterpolation) {
+        motionBudget.noteShed();
+        return;
+    }
+    Keyframe nextKeyframe;
+    if (interpValid && sequenceEngine.peek(&nextKeyframe) &&
+        nextKeyframe.startTime > interpFromKeyframe.startTime) {
+        uint16_t t = easeInOutQ8_8(sequenceTime - interpFromKeyframe.startTime,
+                                   nextKeyframe.startTime - interpFromKeyframe.startTime);
+        uint16_t positions[NUM_SERVOS];
+        interpolateKeyframe(interpFromKeyframe, nextKeyframe, t, positions);
+        // In-betweens of two validated keyframes are within range by
+        // convexity, so the same skip applies
+        bool preValidated = sequenceEngine.validated();
+        for (int i = 0; i < NUM_SERVOS; i++) {
+            uint8_t channel = getServoRange(i)->channel;
+            if (preValidated || validateServoPosition(channel, positions[i])) {
+                servoArbiter.setTarget(ARB_SRC_SCRIPTED, channel, positions[i]);
+            }
+        }
+    }
+
+    // Reset the sequence when it's over
+    if (sequenceEngine.atEnd()) {
+        // Optional: add a delay here before looping
+        sequenceStartTime = 0; // this will restart the sequence on the next loop
+    }
+}
+
+void generateDynamicKeyframe(unsigned long currentTime, bool isTalking) {
+    ScopedProfile prof(PROF_DYNAMIC_KEYFRAME);
+
+    DynamicModeConfig config;
+    // Select config based on whether the animatronic is talking
+    if (isTalking) {
+        memcpy_P(&config, &TALKING_DYNAMIC_CONFIG, sizeof(DynamicModeConfig));
+    } else {
+        memcpy_P(&config, &DEFAULT_DYNAMIC_CONFIG, sizeof(DynamicModeConfig));
+    }
+
+    // Generate procedural servo positions within configured ranges. The
+    // jaw is claimed too: while talking, the higher-priority talking
+    // source simply outranks it at the arbiter, and when talking ends the
+    // jaw crossfades back to the procedural pose.
+    for (int i = 0; i < NUM_SERVOS; i++) {
+        const ServoRange* range = getServoRange(i);
+
+        // Calculate movement range based on intensity
+        uint16_t centerPos = range->home;
+        uint16_t rangeSize = (range->max - range->min) * config.movementIntensity;
+        uint16_t minPos = centerPos - (rangeSize / 2);
+        uint16_t maxPos = centerPos + (rangeSize / 2);
+
+        // Ensure we stay within absolute servo limits
+        minPos = max(minPos, range->min);
+        maxPos = min(maxPos, range->max);
+
+        // Generate random position within calculated range
+        uint16_t targetPosition = random(minPos, maxPos + 1);
+
+        // Validate and stage position
+        if (validateServoPosition(range->channel, targetPosition)) {
+            servoArbiter.setTarget(ARB_SRC_DYNAMIC, range->channel, targetPosition);
+        }
+    }
+
+    // Generate procedural eye movement
+    int16_t maxEyeH = EYE_H_RIGHT * config.movementIntensity;
+    int16_t maxEyeV = EYE_V_DOWN * config.movementIntensity;
+
+    int16_t targetEyeH = random(-maxEyeH, maxEyeH + 1);
+    int16_t targetEyeV = random(-maxEyeV, maxEyeV + 1);
+
+    // Generate random animation duration
+    uint32_t duration = random(config.minHoldDuration, config.maxHoldDuration);
+
+    // Validate and animate eyes
+    if (validateEyePosition(targetEyeH, targetEyeV) && validateTiming(duration)) {
+        requestEyeMove(targetEyeH, targetEyeV, duration);
+    }
+}
+
+void dynamicMoveCallback(unsigned long now) {
+    if (currentMode == OperationMode::DYNAMIC && !sequencePaused) {
+        // Pass the talking state to the keyframe generator
+        generateDynamicKeyframe(now, talkingStartTime != 0);
+    }
+    motionScheduler.schedule(&dynamicMoveEvent,
+                             now + random(dynamicConfig.minMovementInterval,
+                                          dynamicConfig.maxMovementInterval),
+                             dynamicMoveCallback);
+}
+
+void handleJawMovement(unsigned long currentTime) {
+    ScopedProfile prof(PROF_JAW_MOVEMENT);
+
+    static unsigned long lastJawUpdateTime = 0;
+
+    // A live envelope stream overrides the procedural oscillator: table
+    // playback of real TTS energy instead of a synthetic sine. Works with
+    // or without "talk start" -- the stream itself is the talk signal.
+    uint8_t openness;
+    if (talkEnvelope.sample(currentTime, &openness)) {
+        lastJawUpdateTime = 0; // Restart the sine phase cleanly on fallback
+        uint16_t jaw_position = JAW_CLOSED
+            + (uint16_t)(((uint32_t)(JAW_OPEN - JAW_CLOSED) * openness) / 255);
+        if (validateServoPosition(SKULL_JAW_CHANNEL, jaw_position)) {
+            servoArbiter.setTarget(ARB_SRC_TALKING, SKULL_JAW_CHANNEL, jaw_position);
+        }
+        return;
+    }
+
+    if (talkingStartTime == 0) {
+        lastJawUpdateTime = 0;
+        return; // Not talking
+    }
+
+    // Periodically randomize the talking speed and amplitude for a more natural effect
+    if (currentTime - talkSegmentStartTime > currentTalkSegmentDuration) {
+        talkSegmentStartTime = currentTime;
+        currentJawSpeed = random(256, 641);      // Q8.8: 1.0 to 2.5 Hz
+        currentJawAmplitude = random(128, 257);  // Q8.8: 50% to 100%
+        currentTalkSegmentDuration = random(200, 1000);
+        jawOsc.setFrequency(currentJawSpeed);
+        jawOsc.setAmplitude(currentJawAmplitude);
+    }
+
+    // Advance the fixed-point oscillator by the elapsed time. On the first
+    // update of a talk session there is no previous sample, so start fresh.
+    uint32_t dt_ms;
+    if (lastJawUpdateTime == 0) {
+        jawOsc.resetPhase();
+        dt_ms = 0;
+    } else {
+        dt_ms = currentTime - lastJawUpdateTime;
+    }
+    lastJawUpdateTime = currentTime;
+
+    // Sample the sine wave: Q8.8 value in [-256, 256], amplitude applied
+    int16_t sin_wave = jawOsc.next(dt_ms);
+
+    // Map the sine wave to the jaw's servo range (>> 8 drops the Q8.8 scale)
+    uint16_t jaw_range = JAW_OPEN - JAW_CLOSED;
+    uint16_t jaw_position = JAW_CLOSED + (jaw_range / 2)
+                            + (((int32_t)sin_wave * (jaw_range / 2)) >> 8);
+
+    // Ensure the position is within the valid range
+    jaw_position = max(JAW_CLOSED, min(JAW_OPEN, jaw_position));
+
+    // Claim the jaw for the talking source; the arbiter emits it at the
+    // end of the tick (coalesced, non-blocking)
+    if (validateServoPosition(SKULL_JAW_CHANNEL, jaw_position)) {
+        servoArbiter.setTarget(ARB_SRC_TALKING, SKULL_JAW_CHANNEL, jaw_position);
+    }
+}
@@ -0,0 +1,68 @@
+#ifndef MOTION_MODES_H
+#define MOTION_MODES_H
+
+#include <stdint.h>
+#include "config.h"
+
+// =============================================================================
+// MOTION MODE HANDLERS
+// =============================================================================
+//
+// The per-tick animation logic for each operation mode, factored out of the
+// sketch so it compiles for both targets: on the device it runs on the
+// motion task, and under sim/ it runs against stubbed millis/random/serial
+// with simulated time for fast soak testing and workstation profiling.
+//
+// The handlers only talk to the portable modules (sequence engine, servo
+// arbiter, talk envelope, synced clock, scheduler, loop budget) plus the
+// UI event queue; everything hardware- or BLE-specific stays in the sketch.
+// The collaborating objects (sequenceEngine, servoArbiter, ...) are defined
+// by the sketch on the device and by the harness in sim/main.cpp.
+
+// Mode and playback state shared with the BLE command handlers. Defined in
+// motion_modes.cpp; volatile where the BLE task writes and the motion task
+// reads.
+extern volatile OperationMode currentMode;
+extern DynamicModeConfig dynamicConfig;
+extern volatile bool sequencePaused;
+extern volatile unsigned long talkingStartTime;
+extern unsigned long sequenceStartTime;
+extern uint32_t sequencePausedOffset;
+extern bool interpValid;
+extern unsigned long talkSegmentStartTime;
+extern uint32_t currentTalkSegmentDuration;
+
+/**
+ * Runs one tick of scripted playback: fires due keyframes, streams eased
+ * in-between positions, and loops the sequence at its end. All timing is
+ * in show time (see synced_clock.h).
+ * @param currentTime Local millis() at the start of the tick
+ * @param shedInterpolation Skip the optional in-between stage this tick
+ *        (the previous tick blew its budget; the Maestro glides instead)
+ */
+void handleScriptedMode(unsigned long currentTime, bool shedInterpolation);
+
+/**
+ * Generates one procedural keyframe: random servo poses and an eye move
+ * within the active dynamic config's ranges.
+ * @param currentTime Local millis()
+ * @param isTalking Selects the calmer talking-mode movement config
+ */
+void generateDynamicKeyframe(unsigned long currentTime, bool isTalking);
+
+/**
+ * Scheduler callback for dynamic mode: fires a procedural keyframe when
+ * the mode is active, then re-arms itself with a fresh random interval.
+ * Runs on the motion task's timeline.
+ * @param now The scheduler's current time
+ */
+void dynamicMoveCallback(unsigned long now);
+
+/**
+ * Runs one tick of jaw animation: envelope-stream playback when a live
+ * stream is buffered, otherwise the procedural talking oscillator.
+ * @param currentTime Local millis() at the start of the tick
+ */
+void handleJawMovement(unsigned long currentTime);
+
+#endif // MOTION_MODES_H
@@ -0,0 +1,211 @@
+#include "ota_update.h"
+
+#include <Arduino.h>
+#include <esp_heap_caps.h>
+#include <esp_ota_ops.h>
+#include <string.h>
+#include <stdio.h>
+
+#include "config.h"
+#include "sequence_upload.h" // Shared opcodes and crc32Update
+
+// =============================================================================
+// BLE OTA FIRMWARE UPDATE IMPLEMENTATION
+// =============================================================================
+
+OtaUpdate::OtaUpdate()
+    : buf_(nullptr), expected_(0), received_(0), expectedCrc_(0),
+      written_(0), commitRequested_(false), state_(OTA_IDLE),
+      errorReason_("") {
+    status_[0] = '\0';
+}
+
+void OtaUpdate::abortTransfer() {
+    if (buf_ != nullptr) {
+        heap_caps_free(buf_);
+        buf_ = nullptr;
+    }
+    expected_ = 0;
+    received_ = 0;
+    written_ = 0;
+    commitRequested_ = false;
+    state_ = OTA_IDLE;
+}
+
+void OtaUpdate::fail(const char* reason) {
+    errorReason_ = reason;
+    Serial.print("OTA failed: ");
+    Serial.println(reason);
+    if (buf_ != nullptr) {
+        heap_caps_free(buf_);
+        buf_ = nullptr;
+    }
+    commitRequested_ = false;
+    state_ = OTA_ERROR;
+}
+
+void OtaUpdate::handlePacket(const uint8_t* data, size_t len) {
+    if (data == nullptr || len < 1) {
+        return;
+    }
+    // Once a commit is requested the transfer is out of the BLE stack's
+    // hands: the flash task owns buf_ from that point, and a BEGIN/ABORT
+    // here would free it mid-flash (commitRequested_ covers the window
+    // before the task's next poll picks the commit up, same as the
+    // sequence upload's commitPending_ guard). New packets are accepted
+    // again after the flash finishes or fails.
+    if (state_ == OTA_WRITING || commitRequested_) {
+        return;
+    }
+
+    switch (data[0]) {
+        case UPLOAD_OP_BEGIN: {
+            if (len < 9) {
+                return;
+            }
+            abortTransfer();
+            uint32_t totalLen = (uint32_t)data[1] | ((uint32_t)data[2] << 8)
+                              | ((uint32_t)data[3] << 16) | ((uint32_t)data[4] << 24);
+            uint32_t crc = (uint32_t)data[5] | ((uint32_t)data[6] << 8)
+                         | ((uint32_t)data[7] << 16) | ((uint32_t)data[8] << 24);
+
+            const esp_partition_t* target = esp_ota_get_next_update_partition(NULL);
+            if (target == NULL || totalLen == 0 || totalLen > target->size) {
+                fail("no partition or bad size");
+                return;
+            }
+            buf_ = (uint8_t*)heap_caps_malloc(totalLen, MALLOC_CAP_SPIRAM);
+            if (buf_ == nullptr) {
+                fail("PSRAM staging alloc");
+                return;
+            }
+            expected_ = totalLen;
+            expectedCrc_ = crc;
+            received_ = 0;
+            state_ = OTA_RECEIVING;
+            break;
+        }
+
+        case UPLOAD_OP_DATA:
+            if (state_ == OTA_RECEIVING && buf_ != nullptr && len > 1) {
+                size_t payload = len - 1;
+                if (received_ + payload > expected_) {
+                    fail("overflow");
+                } else {
+                    memcpy(buf_ + received_, data + 1, payload);
+                    received_ += payload;
+                }
+            }
+            break;
+
+        case UPLOAD_OP_COMMIT:
+            if (state_ == OTA_RECEIVING && buf_ != nullptr) {
+                commitRequested_ = true; // Background task takes over
+            }
+            break;
+
+        case UPLOAD_OP_ABORT:
+            abortTransfer();
+            break;
+    }
+}
+
+void OtaUpdate::flashStagedImage() {
+    state_ = OTA_WRITING;
+
+    if (received_ != expected_) {
+        fail("short transfer");
+        return;
+    }
+    if (crc32Update(0, buf_, received_) != expectedCrc_) {
+        fail("crc mismatch");
+        return;
+    }
+
+    const esp_partition_t* target = esp_ota_get_next_update_partition(NULL);
+    esp_ota_handle_t handle;
+    if (esp_ota_begin(target, received_, &handle) != ESP_OK) {
+        fail("esp_ota_begin");
+        return;
+    }
+
+    // Small chunks with a yield between each: every flash write stalls
+    // both cores' flash cache for its duration, so spreading the writes
+    // keeps each stall short enough that animation glides across it
+    for (written_ = 0; written_ < received_; ) {
+        uint32_t chunk = received_ - written_;
+        if (chunk > OTA_WRITE_CHUNK_BYTES) {
+            chunk = OTA_WRITE_CHUNK_BYTES;
+        }
+        if (esp_ota_write(handle, buf_ + written_, chunk) != ESP_OK) {
+            esp_ota_abort(handle);
+            fail("esp_ota_write");
+            return;
+        }
+        written_ += chunk;
+        vTaskDelay(pdMS_TO_TICKS(OTA_WRITE_YIELD_MS));
+    }
+
+    // esp_ota_end validates the image header and checksum in flash
+    if (esp_ota_end(handle) != ESP_OK) {
+        fail("image validation");
+        return;
+    }
+
+    heap_caps_free(buf_);
+    buf_ = nullptr;
+    commitRequested_ = false;
+    state_ = OTA_READY;
+    Serial.println("OTA image flashed; swap pending at next idle");
+}
+
+void OtaUpdate::taskLoop() {
+    for (;;) {
+        if (commitRequested_) {
+            flashStagedImage();
+        }
+        vTaskDelay(pdMS_TO_TICKS(100));
+    }
+}
+
+void OtaUpdate::taskTrampoline(void* self) {
+    ((OtaUpdate*)self)->taskLoop();
+}
+
+void OtaUpdate::startTask() {
+    // Same core as the render loop, at the same low priority: flash work
+    // only runs in loop slack and never preempts the motion task
+    xTaskCreatePinnedToCore(taskTrampoline, "ota", OTA_TASK_STACK_SIZE,
+                            this, OTA_TASK_PRIORITY, NULL, RENDER_CORE);
+}
+
+const char* OtaUpdate::statusString() {
+    switch (state_) {
+        case OTA_IDLE:
+            return "OTA idle";
+        case OTA_RECEIVING:
+            snprintf(status_, sizeof(status_), "OTA rx %lu/%lu",
+                     (unsigned long)received_, (unsigned long)expected_);
+            return status_;
+        case OTA_WRITING:
+            snprintf(status_, sizeof(status_), "OTA flash %lu/%lu",
+                     (unsigned long)written_, (unsigned long)expected_);
+            return status_;
+        case OTA_READY:
+            return "OTA ready (applies at idle)";
+        case OTA_ERROR:
+            snprintf(status_, sizeof(status_), "OTA error: %s", errorReason_);
+            return status_;
+    }
+    return "OTA ?";
+}
+
+void OtaUpdate::applyAndReboot() {
+    const esp_partition_t* target = esp_ota_get_next_update_partition(NULL);
+    if (target != NULL && esp_ota_set_boot_partition(target) == ESP_OK) {
+        Serial.println("OTA applying: rebooting into new image");
+        delay(50); // Let the log line drain
+        esp_restart();
+    }
+    fail("set boot partition");
+}
@@ -0,0 +1,86 @@
+#ifndef OTA_UPDATE_H
+#define OTA_UPDATE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// =============================================================================
+// BLE OTA FIRMWARE UPDATE
+// =============================================================================
+//
+// Fleet updates without the ladder: firmware images stream over a dedicated
+// write-without-response characteristic using the same chunk protocol and
+// CRC32 as the sequence upload (BEGIN with length+crc, DATA, COMMIT,
+// ABORT -- see sequence_upload.h). Chunks stage into PSRAM during the
+// show; nothing touches flash until COMMIT.
+//
+// On COMMIT a dedicated low-priority task verifies the CRC and writes the
+// image to the inactive app partition in small chunks with a yield between
+// each, so the cache-stall cost of flash writes is spread thin enough that
+// animation keeps running. The partition swap itself only happens at the
+// next natural idle (no client, sequence stopped, governor idle), so a
+// mid-event update downloads and flashes in the background and the ~2 s
+// reboot lands between shows.
+//
+// The `ota` command reports progress; a failed verify or write leaves the
+// running image untouched.
+
+enum OtaState : uint8_t {
+    OTA_IDLE,       // No transfer in progress
+    OTA_RECEIVING,  // Chunks arriving into PSRAM staging
+    OTA_WRITING,    // Background task flashing the inactive partition
+    OTA_READY,      // Verified and flashed; swap pending at next idle
+    OTA_ERROR       // Last transfer failed (see `ota` output)
+};
+
+class OtaUpdate {
+public:
+    OtaUpdate();
+
+    /**
+     * Handles one transfer packet (same opcodes as the sequence upload).
+     * Producer side; called from the BLE write callback, so it only
+     * stages bytes and flips flags.
+     * @param data Raw packet (opcode + payload)
+     * @param len Packet length in bytes
+     */
+    void handlePacket(const uint8_t* data, size_t len);
+
+    /**
+     * Creates the background flash-writer task. Call once from setup().
+     */
+    void startTask();
+
+    /** @return Current state of the OTA pipeline */
+    OtaState state() const { return state_; }
+
+    /** @return Human-readable state plus progress, for the ota command */
+    const char* statusString();
+
+    /** @return true when a verified image awaits the partition swap */
+    bool readyToApply() const { return state_ == OTA_READY; }
+
+    /**
+     * Activates the flashed image and reboots. Call only at idle.
+     */
+    void applyAndReboot();
+
+private:
+    static void taskTrampoline(void* self);
+    void taskLoop();
+    void flashStagedImage();
+    void fail(const char* reason);
+    void abortTransfer();
+
+    uint8_t* buf_;              // PSRAM staging for the full image
+    uint32_t expected_;
+    uint32_t received_;
+    uint32_t expectedCrc_;
+    volatile uint32_t written_; // Flash progress, for status
+    volatile bool commitRequested_;
+    volatile OtaState state_;
+    const char* errorReason_;
+    char status_[64];
+};
+
+#endif // OTA_UPDATE_H
@@ -0,0 +1,96 @@
+#include "profiler.h"
+
+#include <Arduino.h>
+#include <string.h>
+#include <stdio.h>
+
+// =============================================================================
+// HOT-PATH PROFILER IMPLEMENTATION
+// =============================================================================
+
+static const char* const SECTION_NAMES[PROF_SECTION_COUNT] = {
+    "scripted",
+    "dyn_keyframe",
+    "jaw",
+    "disp_flush",
+    "ble_cmd",
+};
+
+// Per-section accumulators. 32 log2 buckets cover the full uint32_t cycle
+// range; p99 is read off the histogram as the upper bound of the bucket
+// where the 99th percentile falls.
+struct SectionStats {
+    uint32_t count;
+    uint64_t sum;
+    uint32_t minCycles;
+    uint32_t maxCycles;
+    uint32_t histogram[32];
+};
+
+static SectionStats stats[PROF_SECTION_COUNT];
+
+// Index of the highest set bit (0 for a value of 0 or 1)
+static inline uint8_t log2Bucket(uint32_t v) {
+    return (v <= 1) ? 0 : (31 - __builtin_clz(v));
+}
+
+void profilerRecord(ProfSection section, uint32_t cycles) {
+    SectionStats* s = &stats[section];
+    if (s->count == 0 || cycles < s->minCycles) {
+        s->minCycles = cycles;
+    }
+    if (cycles > s->maxCycles) {
+        s->maxCycles = cycles;
+    }
+    s->sum += cycles;
+    s->count++;
+    s->histogram[log2Bucket(cycles)]++;
+}
+
+// Upper bound of the histogram bucket containing the 99th percentile
+static uint32_t estimateP99(const SectionStats* s) {
+    if (s->count == 0) {
+        return 0;
+    }
+    uint32_t threshold = s->count - (s->count / 100);
+    uint32_t cumulative = 0;
+    for (int b = 0; b < 32; b++) {
+        cumulative += s->histogram[b];
+        if (cumulative >= threshold) {
+            return (b >= 31) ? UINT32_MAX : ((uint32_t)1 << (b + 1));
+        }
+    }
+    return s->maxCycles;
+}
+
+size_t profilerFormatReport(char* buf, size_t bufSize) {
+    size_t used = 0;
+    for (int i = 0; i < PROF_SECTION_COUNT; i++) {
+        const SectionStats* s = &stats[i];
+        uint32_t mean = (s->count > 0) ? (uint32_t)(s->sum / s->count) : 0;
+        int n = snprintf(buf + used, bufSize - used,
+                         "%s,%lu,%lu,%lu,%lu,%lu\n",
+                         SECTION_NAMES[i],
+                         (unsigned long)s->count,
+                         (unsigned long)(s->count ? s->minCycles : 0),
+                         (unsigned long)mean,
+                         (unsigned long)estimateP99(s),
+                         (unsigned long)s->maxCycles);
+        if (n < 0 || used + n >= bufSize) {
+            break;
+        }
+        used += n;
+    }
+    return used;
+}
+
+void profilerDump() {
+    char buf[256];
+    profilerFormatReport(buf, sizeof(buf));
+    Serial.println("section,count,min,mean,p99,max (cycles)");
+    Serial.print(buf);
+}
+
+void profilerReset() {
+    memset(stats, 0, sizeof(stats));
+}
@@ -0,0 +1,65 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <esp_cpu.h>
+
+// =============================================================================
+// HOT-PATH PROFILER
+// =============================================================================
+//
+// Cycle-accurate scoped timers around the loop's hot sections. Each section
+// accumulates count/min/max/sum plus a 32-bucket log2 histogram of cycle
+// costs, from which p99 is estimated. Recording is a handful of integer ops,
+// cheap enough to leave enabled in production builds. Results surface via
+// the `stats` BLE command and a periodic Serial dump.
+
+// Instrumented sections. Each section must only be recorded from one task
+// (they are: flush on the render core, the rest on the motion task).
+enum ProfSection : uint8_t {
+    PROF_SCRIPTED_MODE,
+    PROF_DYNAMIC_KEYFRAME,
+    PROF_JAW_MOVEMENT,
+    PROF_DISP_FLUSH,
+    PROF_BLE_COMMAND,
+    PROF_SECTION_COUNT
+};
+
+/**
+ * Records one timed run of a section.
+ * @param section The section being recorded
+ * @param cycles CPU cycles the run took
+ */
+void profilerRecord(ProfSection section, uint32_t cycles);
+
+/**
+ * Formats a compact report of all sections into a buffer, one line per
+ * section: name,count,min,mean,p99,max (cycles).
+ * @param buf Output buffer
+ * @param bufSize Size of the output buffer
+ * @return Number of characters written (excluding the terminator)
+ */
+size_t profilerFormatReport(char* buf, size_t bufSize);
+
+/** Prints the report to Serial. */
+void profilerDump();
+
+/** Clears all accumulated statistics. */
+void profilerReset();
+
+// RAII helper: times the enclosing scope into a section
+class ScopedProfile {
+public:
+    explicit ScopedProfile(ProfSection section)
+        : section_(section), start_(esp_cpu_get_cycle_count()) {}
+    ~ScopedProfile() {
+        profilerRecord(section_, esp_cpu_get_cycle_count() - start_);
+    }
+
+private:
+    ProfSection section_;
+    uint32_t start_;
+};
+
+#endif // PROFILER_H
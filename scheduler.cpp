@@ -0,0 +1,76 @@
+#include "scheduler.h"
+
+#include <stddef.h>
+
+// =============================================================================
+// EARLIEST-DEADLINE EVENT SCHEDULER IMPLEMENTATION
+// =============================================================================
+
+// Signed comparison handles millis() wraparound the same way the previous
+// open-coded timer checks did
+static inline bool timeReached(unsigned long now, unsigned long deadline) {
+    return (long)(now - deadline) >= 0;
+}
+
+EventScheduler::EventScheduler() : head_(NULL) {
+}
+
+void EventScheduler::remove(ScheduledEvent* event) {
+    ScheduledEvent** link = &head_;
+    while (*link != NULL) {
+        if (*link == event) {
+            *link = event->next;
+            event->next = NULL;
+            event->active = false;
+            return;
+        }
+        link = &(*link)->next;
+    }
+}
+
+void EventScheduler::schedule(ScheduledEvent* event, unsigned long deadline,
+                              ScheduledCallback callback) {
+    if (event->active) {
+        remove(event);
+    }
+
+    event->deadline = deadline;
+    event->callback = callback;
+    event->active = true;
+
+    // Insert sorted by deadline so runDue() only inspects the head
+    ScheduledEvent** link = &head_;
+    while (*link != NULL && !timeReached((*link)->deadline, deadline)) {
+        link = &(*link)->next;
+    }
+    event->next = *link;
+    *link = event;
+}
+
+void EventScheduler::cancel(ScheduledEvent* event) {
+    if (event->active) {
+        remove(event);
+    }
+}
+
+void EventScheduler::runDue(unsigned long now) {
+    while (head_ != NULL && timeReached(now, head_->deadline)) {
+        ScheduledEvent* event = head_;
+        head_ = event->next;
+        event->next = NULL;
+        event->active = false;
+        event->callback(now);
+    }
+}
+
+bool EventScheduler::nextDeadline(unsigned long now, unsigned long* delta) const {
+    if (head_ == NULL) {
+        return false;
+    }
+    if (timeReached(now, head_->deadline)) {
+        *delta = 0;
+    } else {
+        *delta = head_->deadline - now;
+    }
+    return true;
+}
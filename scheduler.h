@@ -0,0 +1,72 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <stdint.h>
+
+// =============================================================================
+// EARLIEST-DEADLINE EVENT SCHEDULER
+// =============================================================================
+//
+// Replaces the scattered "if (now - last > interval)" checks in the loops
+// with a single timeline per task: events register a deadline and a
+// callback, runDue() fires everything that is due, and nextDeadline() tells
+// the owning loop exactly how long it may sleep. Events are intrusive list
+// nodes (no allocation) kept sorted by deadline, so runDue() only ever
+// looks at the head.
+//
+// A scheduler instance is single-owner: one for the render loop, one for
+// the motion task. Events must only be (re)scheduled from their owning
+// task; that keeps the list lock-free.
+
+typedef void (*ScheduledCallback)(unsigned long now);
+
+// Intrusive scheduler node. Define statically, one per recurring activity;
+// callbacks reschedule their own node to repeat.
+struct ScheduledEvent {
+    unsigned long deadline;
+    ScheduledCallback callback;
+    ScheduledEvent* next;
+    bool active;
+};
+
+class EventScheduler {
+public:
+    EventScheduler();
+
+    /**
+     * Arms an event. If it was already scheduled it is moved to the new
+     * deadline.
+     * @param event The event node to arm
+     * @param deadline Absolute millis() time the callback should fire
+     * @param callback Function to call when due
+     */
+    void schedule(ScheduledEvent* event, unsigned long deadline,
+                  ScheduledCallback callback);
+
+    /**
+     * Disarms an event. Safe to call on an event that is not scheduled.
+     */
+    void cancel(ScheduledEvent* event);
+
+    /**
+     * Fires every event whose deadline has passed, in deadline order.
+     * Callbacks may reschedule themselves (or other events) freely.
+     * @param now Current millis() time
+     */
+    void runDue(unsigned long now);
+
+    /**
+     * @param now Current millis() time
+     * @param delta Receives milliseconds until the earliest deadline
+     *              (0 if something is already due)
+     * @return false if no events are scheduled
+     */
+    bool nextDeadline(unsigned long now, unsigned long* delta) const;
+
+private:
+    void remove(ScheduledEvent* event);
+
+    ScheduledEvent* head_;
+};
+
+#endif // SCHEDULER_H
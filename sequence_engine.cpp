@@ -0,0 +1,254 @@
+#include "sequence_engine.h"
+
+#include <pgmspace.h>
+#include <string.h>
+#include <LittleFS.h>
+
+// =============================================================================
+// KEYFRAME SEQUENCE ENGINE IMPLEMENTATION
+// =============================================================================
+
+SequenceEngine::SequenceEngine()
+    : builtinFrames_(nullptr), builtinCount_(0), usingFile_(false),
+      validated_(false), count_(0), duration_(0), cursor_(0),
+      chunkBase_(-1), chunkCount_(0) {
+}
+
+bool SequenceEngine::begin(const PackedKeyframe* builtinFrames, int builtinCount) {
+    builtinFrames_ = builtinFrames;
+    builtinCount_ = builtinCount;
+
+    if (!LittleFS.begin(true)) {
+        Serial.println("LittleFS mount failed; using built-in sequence");
+    } else if (loadFile(SEQUENCE_FILE_PATH)) {
+        return true;
+    }
+
+    // Fall back to the built-in PROGMEM sequence (compile-time validated)
+    usingFile_ = false;
+    validated_ = true;
+    count_ = builtinCount_;
+    if (count_ > 0) {
+        duration_ = pgm_read_dword(&builtinFrames_[count_ - 1].startTime);
+    }
+    cursor_ = 0;
+    return count_ > 0;
+}
+
+bool SequenceEngine::loadFile(const char* path) {
+    fs::File file = LittleFS.open(path, "r");
+    if (!file) {
+        return false;
+    }
+
+    SequenceFileHeader header;
+    if (file.read((uint8_t*)&header, sizeof(header)) != sizeof(header) ||
+        memcmp(header.magic, "IBSQ", 4) != 0 ||
+        header.version != SEQUENCE_FILE_VERSION ||
+        header.numServos != NUM_SERVOS ||
+        header.keyframeCount == 0) {
+        Serial.print("Invalid sequence file: ");
+        Serial.println(path);
+        file.close();
+        return false;
+    }
+
+    // Sanity-check the payload length against the header
+    size_t expected = sizeof(SequenceFileHeader)
+                    + (size_t)header.keyframeCount * sizeof(SequenceFileRecord);
+    if (file.size() < expected) {
+        Serial.print("Truncated sequence file: ");
+        Serial.println(path);
+        file.close();
+        return false;
+    }
+
+    if (file_) {
+        file_.close();
+    }
+    file_ = file;
+    usingFile_ = true;
+    count_ = header.keyframeCount;
+    cursor_ = 0;
+    chunkBase_ = -1;
+    chunkCount_ = 0;
+
+    Keyframe last;
+    duration_ = readFileRecord(count_ - 1, &last) ? last.startTime : 0;
+
+    // One load-time pass over every record so playback never has to
+    // validate again: positions within the (possibly calibrated) ranges,
+    // eyes within limits, start times strictly increasing. Streams through
+    // the chunk cache, so the cost is the file read, once.
+    uint32_t prevStart = 0;
+    for (int i = 0; i < count_; i++) {
+        Keyframe kf;
+        bool ok = readFileRecord(i, &kf) &&
+                  (i == 0 || kf.startTime > prevStart) &&
+                  validateEyePosition(kf.eye_h_pos, kf.eye_v_pos);
+        for (int s = 0; ok && s < NUM_SERVOS; s++) {
+            ok = validateServoPosition(s, kf.positions[s]);
+        }
+        if (!ok) {
+            Serial.print("Rejected sequence file (bad keyframe ");
+            Serial.print(i);
+            Serial.print("): ");
+            Serial.println(path);
+            closeFile();
+            return false;
+        }
+        prevStart = kf.startTime;
+    }
+    validated_ = true;
+    cursor_ = 0;
+    chunkBase_ = -1; // Don't let the scan pollute locality at the start
+
+    Serial.print("Loaded sequence: ");
+    Serial.print(count_);
+    Serial.println(" keyframes");
+    return true;
+}
+
+void SequenceEngine::closeFile() {
+    if (file_) {
+        file_.close();
+    }
+    usingFile_ = false;
+    validated_ = true; // The built-in fallback is compile-time validated
+    count_ = builtinCount_;
+    duration_ = 0;
+    if (count_ > 0) {
+        duration_ = pgm_read_dword(&builtinFrames_[count_ - 1].startTime);
+    }
+    cursor_ = 0;
+    chunkBase_ = -1;
+    chunkCount_ = 0;
+}
+
+bool SequenceEngine::readFileRecord(int index, Keyframe* out) {
+    if (index < 0 || index >= count_) {
+        return false;
+    }
+
+    // Serve from the chunk cache when possible; otherwise stream in the
+    // chunk containing the requested index
+    if (chunkBase_ < 0 || index < chunkBase_ || index >= chunkBase_ + chunkCount_) {
+        int base = index - (index % SEQUENCE_CHUNK_KEYFRAMES);
+        int toRead = count_ - base;
+        if (toRead > SEQUENCE_CHUNK_KEYFRAMES) {
+            toRead = SEQUENCE_CHUNK_KEYFRAMES;
+        }
+
+        size_t offset = sizeof(SequenceFileHeader)
+                      + (size_t)base * sizeof(SequenceFileRecord);
+        if (!file_.seek(offset)) {
+            return false;
+        }
+
+        SequenceFileRecord records[SEQUENCE_CHUNK_KEYFRAMES];
+        size_t want = (size_t)toRead * sizeof(SequenceFileRecord);
+        if (file_.read((uint8_t*)records, want) != want) {
+            return false;
+        }
+
+        for (int i = 0; i < toRead; i++) {
+            chunk_[i].startTime = records[i].startTime;
+            memcpy(chunk_[i].positions, records[i].positions, sizeof(chunk_[i].positions));
+            chunk_[i].eye_h_pos = records[i].eye_h_pos;
+            chunk_[i].eye_v_pos = records[i].eye_v_pos;
+        }
+        chunkBase_ = base;
+        chunkCount_ = toRead;
+    }
+
+    *out = chunk_[index - chunkBase_];
+    return true;
+}
+
+bool SequenceEngine::fetch(int index, Keyframe* out) {
+    if (index < 0 || index >= count_) {
+        return false;
+    }
+    if (usingFile_) {
+        return readFileRecord(index, out);
+    }
+    // Widen the packed flash record to the runtime Keyframe
+    PackedKeyframe packed;
+    memcpy_P(&packed, &builtinFrames_[index], sizeof(PackedKeyframe));
+    out->startTime = packed.startTime;
+    memcpy(out->positions, packed.positions, sizeof(out->positions));
+    out->eye_h_pos = packed.eye_h_pos;
+    out->eye_v_pos = packed.eye_v_pos;
+    return true;
+}
+
+bool SequenceEngine::startTimeAt(int index, uint32_t* out) {
+    if (index < 0 || index >= count_) {
+        return false;
+    }
+    if (!usingFile_) {
+        *out = pgm_read_dword(&builtinFrames_[index].startTime);
+        return true;
+    }
+    Keyframe kf;
+    if (!readFileRecord(index, &kf)) {
+        return false;
+    }
+    *out = kf.startTime;
+    return true;
+}
+
+void SequenceEngine::seekTo(uint32_t timeMs) {
+    // Binary search for the first keyframe with startTime >= timeMs
+    int lo = 0;
+    int hi = count_;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        uint32_t t;
+        if (!startTimeAt(mid, &t)) {
+            break;
+        }
+        if (t < timeMs) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    cursor_ = lo;
+}
+
+bool SequenceEngine::peek(Keyframe* out) {
+    return fetch(cursor_, out);
+}
+
+void SequenceEngine::advance() {
+    if (cursor_ < count_) {
+        cursor_++;
+    }
+}
+
+// =============================================================================
+// KEYFRAME INTERPOLATION
+// =============================================================================
+
+uint16_t easeInOutQ8_8(uint32_t elapsed, uint32_t duration) {
+    if (duration == 0 || elapsed >= duration) {
+        return 256;
+    }
+
+    // Linear progress in Q8.8, then the smoothstep cubic 3t^2 - 2t^3,
+    // which is 0 at t=0 and 256 at t=256 with zero slope at both ends
+    uint32_t t = (elapsed << 8) / duration;
+    uint32_t t2 = (t * t) >> 8;
+    uint32_t t3 = (t2 * t) >> 8;
+    return (uint16_t)(3 * t2 - 2 * t3);
+}
+
+void interpolateKeyframe(const Keyframe& from, const Keyframe& to,
+                         uint16_t t_q8_8, uint16_t* positions) {
+    for (int i = 0; i < NUM_SERVOS; i++) {
+        int32_t delta = (int32_t)to.positions[i] - (int32_t)from.positions[i];
+        positions[i] = (uint16_t)((int32_t)from.positions[i]
+                                  + ((delta * t_q8_8) >> 8));
+    }
+}
@@ -0,0 +1,237 @@
+#ifndef SEQUENCE_ENGINE_H
+#define SEQUENCE_ENGINE_H
+
+#include <stdint.h>
+#include <FS.h>
+#include "config.h"
+
+// =============================================================================
+// KEYFRAME SEQUENCE ENGINE
+// =============================================================================
+//
+// Replaces the direct walk over the PROGMEM sequence[] array so shows are no
+// longer capped at what fits in flash-resident program data. Sequences can
+// come from two sources:
+//
+//   - the built-in PROGMEM array (always available as a fallback), or
+//   - a compact binary file on LittleFS (header + packed keyframe records),
+//     streamed through a small chunk cache so only a handful of keyframes
+//     are ever resident in RAM.
+//
+// The cursor advances incrementally during playback (no per-loop re-reads),
+// and seekTo() binary-searches on startTime so start/pause/resume at an
+// arbitrary offset costs O(log n) reads.
+
+// A single keyframe: servo targets plus an eye pose, fired at startTime
+// milliseconds from the beginning of the sequence.
+struct Keyframe {
+  uint32_t startTime;
+  uint16_t positions[NUM_SERVOS];
+  int16_t eye_h_pos;
+  int16_t eye_v_pos;
+};
+
+// Flash-resident storage form of the built-in sequence: packed, with eye
+// offsets narrowed to int8 (their legal range is +/-EYE_MAX_*_OFFSET), 12
+// bytes per keyframe against Keyframe's padded 16. Expanded to Keyframe on
+// fetch. startTime stays absolute -- delta timestamps would shrink it
+// further but turn seekTo()'s O(log n) binary search into a prefix walk.
+struct __attribute__((packed)) PackedKeyframe {
+  uint32_t startTime;
+  uint16_t positions[NUM_SERVOS];
+  int8_t eye_h_pos;
+  int8_t eye_v_pos;
+};
+
+// -----------------------------------------------------------------------------
+// Compile-time sequence validation. The built-in sequence is fully known at
+// build time, so every keyframe is checked against the compiled servo range
+// and eye limits in a static_assert next to the array -- playback then never
+// runs validateServoPosition() on a source the compiler already proved.
+// (C++11 constexpr, hence the single-return recursion.)
+// -----------------------------------------------------------------------------
+
+constexpr uint16_t builtinServoMin(int i) {
+    return i == SKULL_PAN_CHANNEL ? PAN_LEFT
+         : i == SKULL_NOD_CHANNEL ? NOD_UP
+         : JAW_CLOSED;
+}
+
+constexpr uint16_t builtinServoMax(int i) {
+    return i == SKULL_PAN_CHANNEL ? PAN_RIGHT
+         : i == SKULL_NOD_CHANNEL ? NOD_DOWN
+         : JAW_OPEN;
+}
+
+constexpr bool keyframePositionsValid(const PackedKeyframe& k, int i = 0) {
+    return i >= NUM_SERVOS
+        || (k.positions[i] >= builtinServoMin(i) &&
+            k.positions[i] <= builtinServoMax(i) &&
+            keyframePositionsValid(k, i + 1));
+}
+
+constexpr bool keyframeValid(const PackedKeyframe& k) {
+    return keyframePositionsValid(k) &&
+           k.eye_h_pos >= -EYE_MAX_H_OFFSET && k.eye_h_pos <= EYE_MAX_H_OFFSET &&
+           k.eye_v_pos >= -EYE_MAX_V_OFFSET && k.eye_v_pos <= EYE_MAX_V_OFFSET;
+}
+
+/**
+ * Validates a whole authored sequence: every keyframe in range and start
+ * times strictly increasing. Use in a static_assert beside the array.
+ */
+constexpr bool sequenceValid(const PackedKeyframe* frames, int count, int i = 0) {
+    return i >= count
+        || (keyframeValid(frames[i]) &&
+            (i == 0 || frames[i].startTime > frames[i - 1].startTime) &&
+            sequenceValid(frames, count, i + 1));
+}
+
+// On-flash sequence file layout (little-endian, packed)
+struct __attribute__((packed)) SequenceFileHeader {
+    char magic[4];          // "IBSQ"
+    uint16_t version;       // SEQUENCE_FILE_VERSION
+    uint16_t numServos;     // Must equal NUM_SERVOS
+    uint32_t keyframeCount;
+};
+
+struct __attribute__((packed)) SequenceFileRecord {
+    uint32_t startTime;
+    uint16_t positions[NUM_SERVOS];
+    int16_t eye_h_pos;
+    int16_t eye_v_pos;
+};
+
+const uint16_t SEQUENCE_FILE_VERSION = 1;
+
+// Default path of the uploaded show on LittleFS
+#define SEQUENCE_FILE_PATH "/show.seq"
+
+// Keyframes cached per chunk read when streaming from flash
+const int SEQUENCE_CHUNK_KEYFRAMES = 16;
+
+class SequenceEngine {
+public:
+    SequenceEngine();
+
+    /**
+     * Mounts LittleFS and selects the sequence source: the file at
+     * SEQUENCE_FILE_PATH if present and valid, otherwise the built-in
+     * PROGMEM sequence. Call once from setup().
+     * @param builtinFrames The PROGMEM fallback sequence (packed form,
+     *        compile-time validated at its definition)
+     * @param builtinCount Number of keyframes in the fallback
+     * @return true if any source is available
+     */
+    bool begin(const PackedKeyframe* builtinFrames, int builtinCount);
+
+    /**
+     * Switches to a sequence file on LittleFS, validating its header and
+     * then every record (range and monotonic timing) in one load-time
+     * pass. Falls back to the built-in sequence on failure.
+     * @param path Absolute LittleFS path
+     * @return true if the file was opened and fully validated
+     */
+    bool loadFile(const char* path);
+
+    /**
+     * @return true when every keyframe of the active source has already
+     *         been validated (compile-time for the built-in sequence,
+     *         load-time for files), so playback can skip per-keyframe
+     *         runtime checks. The guarantee is against the compiled
+     *         default ranges; NVS calibration narrower than those is
+     *         still enforced by the Maestro's own limits.
+     */
+    bool validated() const { return validated_; }
+
+    /**
+     * Closes the file-backed source and reverts to the built-in PROGMEM
+     * sequence. Used by the upload path so the installed file can be
+     * renamed over; follow with loadFile() to adopt the new file.
+     */
+    void closeFile();
+
+    /**
+     * Positions the cursor at the first keyframe with startTime >= timeMs
+     * using binary search on startTime: O(log n) record reads.
+     * @param timeMs Offset into the sequence in milliseconds
+     */
+    void seekTo(uint32_t timeMs);
+
+    /**
+     * Reads the keyframe under the cursor without advancing.
+     * @param out Receives the keyframe
+     * @return false if the cursor is past the end of the sequence
+     */
+    bool peek(Keyframe* out);
+
+    /** Advances the cursor to the next keyframe. */
+    void advance();
+
+    /**
+     * Reads only the startTime of an arbitrary keyframe (cheap: one field,
+     * served from the chunk cache when possible).
+     * @param index Keyframe index
+     * @param out Receives the start time
+     * @return false if index is out of range
+     */
+    bool startTimeAt(int index, uint32_t* out);
+
+    /** @return true when the cursor has consumed the whole sequence */
+    bool atEnd() const { return cursor_ >= count_; }
+
+    /** @return Current cursor index */
+    int index() const { return cursor_; }
+
+    /** @return Total number of keyframes in the active sequence */
+    int count() const { return count_; }
+
+    /** @return Start time of the last keyframe (the sequence duration) */
+    uint32_t duration() const { return duration_; }
+
+private:
+    bool fetch(int index, Keyframe* out);
+    bool readFileRecord(int index, Keyframe* out);
+
+    const PackedKeyframe* builtinFrames_; // PROGMEM
+    int builtinCount_;
+
+    fs::File file_;
+    bool usingFile_;
+    bool validated_;
+
+    int count_;
+    uint32_t duration_;
+    int cursor_;
+
+    // Chunk cache for the file-backed source
+    Keyframe chunk_[SEQUENCE_CHUNK_KEYFRAMES];
+    int chunkBase_;
+    int chunkCount_;
+};
+
+// =============================================================================
+// KEYFRAME INTERPOLATION
+// =============================================================================
+
+/**
+ * Cubic ease-in-out progress curve (the integer counterpart of the
+ * lv_anim_path_ease_in_out path already used for the eyes).
+ * @param elapsed Milliseconds since the segment started
+ * @param duration Total segment duration in milliseconds
+ * @return Eased progress in Q8.8 (0 == start, 256 == end)
+ */
+uint16_t easeInOutQ8_8(uint32_t elapsed, uint32_t duration);
+
+/**
+ * Evaluates the in-between servo positions for a point between two
+ * keyframes.
+ * @param from Keyframe the segment starts at
+ * @param to Keyframe the segment ends at
+ * @param t_q8_8 Eased progress in Q8.8 (from easeInOutQ8_8)
+ * @param positions Receives NUM_SERVOS interpolated positions
+ */
+void interpolateKeyframe(const Keyframe& from, const Keyframe& to,
+                         uint16_t t_q8_8, uint16_t* positions);
+
+#endif // SEQUENCE_ENGINE_H
@@ -0,0 +1,190 @@
+#include "sequence_upload.h"
+
+#include <Arduino.h>
+#include <LittleFS.h>
+#include <esp_heap_caps.h>
+#include <string.h>
+
+#include "config.h"
+
+// =============================================================================
+// BULK SEQUENCE UPLOAD IMPLEMENTATION
+// =============================================================================
+
+// Nibble-at-a-time CRC32 table (reflected, polynomial 0xEDB88320): 16
+// entries instead of 256, a good fit for flash-resident constants
+static const uint32_t CRC32_NIBBLE_TABLE[16] PROGMEM = {
+    0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC,
+    0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+    0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C,
+    0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+};
+
+uint32_t crc32Update(uint32_t crc, const uint8_t* data, size_t len) {
+    crc = ~crc;
+    for (size_t i = 0; i < len; i++) {
+        crc ^= data[i];
+        crc = (crc >> 4) ^ pgm_read_dword(&CRC32_NIBBLE_TABLE[crc & 0x0F]);
+        crc = (crc >> 4) ^ pgm_read_dword(&CRC32_NIBBLE_TABLE[crc & 0x0F]);
+    }
+    return ~crc;
+}
+
+SequenceUpload::SequenceUpload()
+    : buf_(nullptr), expected_(0), received_(0), expectedCrc_(0),
+      overflowed_(false), commitPending_(false) {
+}
+
+void SequenceUpload::abort() {
+    if (buf_ != nullptr) {
+        heap_caps_free(buf_);
+        buf_ = nullptr;
+    }
+    expected_ = 0;
+    received_ = 0;
+    overflowed_ = false;
+    commitPending_ = false;
+}
+
+bool SequenceUpload::beginTransfer(uint32_t totalLen, uint32_t crc) {
+    abort(); // A new BEGIN implicitly discards any half-finished transfer
+
+    if (totalLen < sizeof(SequenceFileHeader) ||
+        totalLen > SEQUENCE_UPLOAD_MAX_BYTES) {
+        return false;
+    }
+
+    // Stage in PSRAM (same pool as the sclera cache); internal RAM cannot
+    // spare a couple hundred KB
+    buf_ = (uint8_t*)heap_caps_malloc(totalLen, MALLOC_CAP_SPIRAM);
+    if (buf_ == nullptr) {
+        return false;
+    }
+    expected_ = totalLen;
+    expectedCrc_ = crc;
+    received_ = 0;
+    return true;
+}
+
+void SequenceUpload::handlePacket(const uint8_t* data, size_t len) {
+    if (data == nullptr || len < 1 || commitPending_) {
+        return; // Ignore packets while a commit is in flight
+    }
+
+    switch (data[0]) {
+        case UPLOAD_OP_BEGIN:
+            if (len >= 9) {
+                uint32_t totalLen = (uint32_t)data[1] | ((uint32_t)data[2] << 8)
+                                  | ((uint32_t)data[3] << 16) | ((uint32_t)data[4] << 24);
+                uint32_t crc = (uint32_t)data[5] | ((uint32_t)data[6] << 8)
+                             | ((uint32_t)data[7] << 16) | ((uint32_t)data[8] << 24);
+                beginTransfer(totalLen, crc);
+            }
+            break;
+
+        case UPLOAD_OP_DATA:
+            if (buf_ != nullptr && len > 1) {
+                size_t payload = len - 1;
+                if (received_ + payload > expected_) {
+                    overflowed_ = true; // Reported at commit, not mid-stream
+                } else {
+                    memcpy(buf_ + received_, data + 1, payload);
+                    received_ += payload;
+                }
+            }
+            break;
+
+        case UPLOAD_OP_COMMIT:
+            if (buf_ != nullptr) {
+                commitPending_ = true; // Motion task verifies and swaps
+            }
+            break;
+
+        case UPLOAD_OP_ABORT:
+            abort();
+            break;
+    }
+}
+
+// Content validation of the staged image before the installed show is
+// touched: the CRC protects the transport, not the authoring, and a
+// CRC-correct file from a buggy exporter must not cost us the show that
+// is already installed. Same checks as SequenceEngine::loadFile, run over
+// the PSRAM staging buffer instead of flash.
+// Returns nullptr when valid, otherwise the commit status string.
+static const char* validateStagedImage(const uint8_t* buf, size_t len) {
+    SequenceFileHeader header;
+    if (len < sizeof(header)) {
+        return "ERR upload header";
+    }
+    memcpy(&header, buf, sizeof(header));
+    if (memcmp(header.magic, "IBSQ", 4) != 0 ||
+        header.version != SEQUENCE_FILE_VERSION ||
+        header.numServos != NUM_SERVOS ||
+        header.keyframeCount == 0) {
+        return "ERR upload header";
+    }
+
+    size_t expected = sizeof(SequenceFileHeader)
+                    + (size_t)header.keyframeCount * sizeof(SequenceFileRecord);
+    if (len < expected) {
+        return "ERR upload truncated";
+    }
+
+    uint32_t prevStart = 0;
+    for (uint32_t i = 0; i < header.keyframeCount; i++) {
+        SequenceFileRecord rec;
+        memcpy(&rec, buf + sizeof(SequenceFileHeader)
+                         + (size_t)i * sizeof(SequenceFileRecord), sizeof(rec));
+        bool ok = (i == 0 || rec.startTime > prevStart) &&
+                  validateEyePosition(rec.eye_h_pos, rec.eye_v_pos);
+        for (int s = 0; ok && s < NUM_SERVOS; s++) {
+            ok = validateServoPosition(s, rec.positions[s]);
+        }
+        if (!ok) {
+            return "ERR upload keyframe";
+        }
+        prevStart = rec.startTime;
+    }
+    return nullptr;
+}
+
+const char* SequenceUpload::processCommit(SequenceEngine& engine) {
+    const char* status;
+
+    if (overflowed_) {
+        status = "ERR upload overflow";
+    } else if (received_ != expected_) {
+        status = "ERR upload short";
+    } else if (crc32Update(0, buf_, received_) != expectedCrc_) {
+        status = "ERR upload crc";
+    } else if ((status = validateStagedImage(buf_, received_)) != nullptr) {
+        // Invalid content: the installed show has not been touched
+    } else {
+        // Stage to a temp file so a power cut mid-write can never corrupt
+        // the installed show
+        fs::File tmp = LittleFS.open(SEQUENCE_UPLOAD_TMP_PATH, "w");
+        if (!tmp || tmp.write(buf_, received_) != received_) {
+            if (tmp) tmp.close();
+            LittleFS.remove(SEQUENCE_UPLOAD_TMP_PATH);
+            status = "ERR upload write";
+        } else {
+            tmp.close();
+
+            // Atomic swap: close the engine's handle on the old file,
+            // rename the verified image over it, hot reload
+            engine.closeFile();
+            LittleFS.remove(SEQUENCE_FILE_PATH);
+            if (LittleFS.rename(SEQUENCE_UPLOAD_TMP_PATH, SEQUENCE_FILE_PATH) &&
+                engine.loadFile(SEQUENCE_FILE_PATH)) {
+                status = "OK";
+            } else {
+                // Engine already fell back to the built-in sequence
+                status = "ERR upload swap";
+            }
+        }
+    }
+
+    abort();
+    return status;
+}
@@ -0,0 +1,93 @@
+#ifndef SEQUENCE_UPLOAD_H
+#define SEQUENCE_UPLOAD_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "sequence_engine.h"
+
+// =============================================================================
+// BULK SEQUENCE UPLOAD OVER BLE
+// =============================================================================
+//
+// Replaces recompile-and-reflash as the way to change the scripted show.
+// The controller streams the complete sequence file (SequenceFileHeader +
+// packed records) over a dedicated write-without-response characteristic
+// in MTU-sized chunks; at 517-byte MTU a 10,000-keyframe show is ~240
+// packets and uploads in a few seconds.
+//
+// Packets (first byte is the opcode):
+//   0x01 BEGIN  u32 totalLen, u32 crc32 (little-endian) -- allocates staging
+//   0x02 DATA   payload bytes, appended in order
+//   0x03 COMMIT verify + atomic swap (performed by the motion task)
+//   0x04 ABORT  discard staging
+//
+// Chunks land in a PSRAM staging buffer, not flash: LittleFS writes inside
+// the BLE callback would stall the stack and drop packets, while a memcpy
+// is nanoseconds. The motion task performs the commit -- CRC32 over the
+// staged image, header validation, write to a temp file, then an atomic
+// rename over SEQUENCE_FILE_PATH and a hot reload of the engine. A failed
+// verify leaves the running show untouched.
+
+// Staging temp file; renamed over SEQUENCE_FILE_PATH only after the CRC
+// and header check out
+#define SEQUENCE_UPLOAD_TMP_PATH "/show.seq.tmp"
+
+// Upload opcodes
+const uint8_t UPLOAD_OP_BEGIN  = 0x01;
+const uint8_t UPLOAD_OP_DATA   = 0x02;
+const uint8_t UPLOAD_OP_COMMIT = 0x03;
+const uint8_t UPLOAD_OP_ABORT  = 0x04;
+
+class SequenceUpload {
+public:
+    SequenceUpload();
+
+    /**
+     * Handles one upload packet. Producer side; called from the BLE write
+     * callback, so it only stages bytes and flips flags -- no flash I/O.
+     * @param data Raw packet (opcode + payload)
+     * @param len Packet length in bytes
+     */
+    void handlePacket(const uint8_t* data, size_t len);
+
+    /**
+     * @return true once a COMMIT packet has arrived and the staged image
+     *         awaits verification
+     */
+    bool commitPending() const { return commitPending_; }
+
+    /**
+     * Verifies and installs the staged sequence: CRC32 check, write to
+     * SEQUENCE_UPLOAD_TMP_PATH, atomic rename over SEQUENCE_FILE_PATH,
+     * hot reload of the engine. Consumer side; called from the motion
+     * task when commitPending(). Blocks for the flash write (~1 s for a
+     * large show), which is acceptable while the show is being replaced.
+     * @param engine The sequence engine to hot-swap
+     * @return Status string suitable for respond(): "OK" or "ERR ..."
+     */
+    const char* processCommit(SequenceEngine& engine);
+
+private:
+    void abort();
+    bool beginTransfer(uint32_t totalLen, uint32_t crc);
+
+    uint8_t* buf_;              // PSRAM staging buffer
+    uint32_t expected_;         // Total bytes announced by BEGIN
+    uint32_t received_;         // Bytes staged so far
+    uint32_t expectedCrc_;      // CRC32 announced by BEGIN
+    bool overflowed_;           // DATA exceeded expected_
+    volatile bool commitPending_;
+};
+
+/**
+ * Standard reflected CRC32 (polynomial 0xEDB88320), nibble-table driven,
+ * chainable zlib-style: start with 0 and feed the previous return value
+ * to checksum across multiple buffers.
+ * @param crc Running CRC (0 for the first call)
+ * @param data Bytes to checksum
+ * @param len Length in bytes
+ * @return Updated CRC32
+ */
+uint32_t crc32Update(uint32_t crc, const uint8_t* data, size_t len);
+
+#endif // SEQUENCE_UPLOAD_H
@@ -0,0 +1,108 @@
+#include "servo_arbiter.h"
+
+#include <Arduino.h>
+#include "sequence_engine.h" // easeInOutQ8_8 for the crossfade curve
+
+// =============================================================================
+// PRIORITY SERVO ARBITER IMPLEMENTATION
+// =============================================================================
+
+// Claim lifetime per source. Streaming sources (talking, scripted) renew
+// every tick, so a short TTL releases their servos promptly when they stop;
+// one-shot direct commands hold their servo for a beat before playback
+// takes it back; the dynamic generator fires seconds apart and is lowest
+// priority anyway, so its claims simply persist between fires.
+static const uint32_t CLAIM_TTL_MS[ARB_SOURCE_COUNT] = {
+    ARBITER_DIRECT_TTL_MS,   // ARB_SRC_DIRECT
+    ARBITER_STREAM_TTL_MS,   // ARB_SRC_TALKING
+    ARBITER_STREAM_TTL_MS,   // ARB_SRC_SCRIPTED
+    ARBITER_DYNAMIC_TTL_MS   // ARB_SRC_DYNAMIC
+};
+
+ServoArbiter::ServoArbiter(ServoTxQueue &txQueue) : txQueue_(txQueue) {
+    for (int src = 0; src < ARB_SOURCE_COUNT; src++) {
+        for (int ch = 0; ch < NUM_SERVOS; ch++) {
+            claims_[src][ch].valid = false;
+        }
+    }
+    for (int ch = 0; ch < NUM_SERVOS; ch++) {
+        winner_[ch] = -1;
+        haveOutput_[ch] = false;
+        fading_[ch] = false;
+    }
+}
+
+void ServoArbiter::setTarget(ArbiterSource source, uint8_t channel, uint16_t position) {
+    if (source >= ARB_SOURCE_COUNT || channel >= NUM_SERVOS) {
+        return;
+    }
+    Claim &claim = claims_[source][channel];
+    claim.position = position;
+    claim.stampMs = millis();
+    claim.valid = true;
+}
+
+ArbiterSource ServoArbiter::ownerOf(uint8_t channel) const {
+    if (channel < NUM_SERVOS && winner_[channel] >= 0) {
+        return (ArbiterSource)winner_[channel];
+    }
+    return ARB_SOURCE_COUNT;
+}
+
+void ServoArbiter::resolve(unsigned long now) {
+    for (int ch = 0; ch < NUM_SERVOS; ch++) {
+        // Highest-priority live claim wins; expired claims are dropped as
+        // they are passed over
+        int best = -1;
+        for (int src = 0; src < ARB_SOURCE_COUNT; src++) {
+            Claim &claim = claims_[src][ch];
+            if (!claim.valid) {
+                continue;
+            }
+            if ((unsigned long)(now - claim.stampMs) > CLAIM_TTL_MS[src]) {
+                claim.valid = false;
+                continue;
+            }
+            best = src;
+            break;
+        }
+
+        if (best < 0) {
+            // No live claim: the servo holds its last target (the Maestro
+            // does that on its own), ready for the next owner's crossfade
+            winner_[ch] = -1;
+            continue;
+        }
+
+        uint16_t target = claims_[best][ch].position;
+
+        // Ownership change: fade from wherever the servo last was so the
+        // new source never snaps it
+        if (winner_[ch] != best) {
+            if (haveOutput_[ch] && lastOutput_[ch] != target) {
+                fadeFrom_[ch] = lastOutput_[ch];
+                fadeStart_[ch] = now;
+                fading_[ch] = true;
+            }
+            winner_[ch] = best;
+        }
+
+        uint16_t out = target;
+        if (fading_[ch]) {
+            unsigned long elapsed = now - fadeStart_[ch];
+            if (elapsed >= ARBITER_CROSSFADE_MS) {
+                fading_[ch] = false;
+            } else {
+                uint16_t t = easeInOutQ8_8(elapsed, ARBITER_CROSSFADE_MS);
+                out = fadeFrom_[ch]
+                    + (uint16_t)(((int32_t)target - fadeFrom_[ch]) * t / 256);
+            }
+        }
+
+        // The TX queue coalesces and deadband-suppresses, so emitting the
+        // resolved target every tick costs nothing when it hasn't moved
+        txQueue_.enqueueTarget(ch, out);
+        lastOutput_[ch] = out;
+        haveOutput_[ch] = true;
+    }
+}
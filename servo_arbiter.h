@@ -0,0 +1,83 @@
+#ifndef SERVO_ARBITER_H
+#define SERVO_ARBITER_H
+
+#include <stdint.h>
+#include "config.h"
+#include "servo_tx_queue.h"
+
+// =============================================================================
+// PRIORITY SERVO ARBITER
+// =============================================================================
+//
+// One resolver between every animation source and the wire. Scripted
+// playback, the dynamic generator, the talking engine, and direct BLE
+// `servo` commands each stage per-servo targets into a claim table instead
+// of racing each other at the TX queue; once per motion tick resolve()
+// picks the highest-priority live claim per servo and emits exactly one
+// target through the batched writer.
+//
+// Claims expire: a source that stops producing (talk ends, a one-shot
+// `servo` command ages out) releases its servos to lower-priority sources
+// automatically, no explicit handoff calls. When ownership of a servo
+// changes hands, the output crossfades from the old position to the new
+// owner's target over ARBITER_CROSSFADE_MS so layered behaviors (a talk
+// ending mid-scripted-nod) never snap.
+
+// Animation sources in priority order: lower value wins a contested servo
+enum ArbiterSource {
+    ARB_SRC_DIRECT = 0,   // BLE servo command / binary opcode
+    ARB_SRC_TALKING,      // Jaw oscillator or envelope playback
+    ARB_SRC_SCRIPTED,     // Keyframe sequence playback
+    ARB_SRC_DYNAMIC,      // Procedural movement generator
+    ARB_SOURCE_COUNT
+};
+
+class ServoArbiter {
+public:
+    explicit ServoArbiter(ServoTxQueue &txQueue);
+
+    /**
+     * Stages a source's target for one servo. The claim stays live for the
+     * source's TTL and is renewed by every call. Callers validate the
+     * position first, same as before.
+     * @param source The producing animation source
+     * @param channel The servo channel
+     * @param position Target position in quarter-microseconds
+     */
+    void setTarget(ArbiterSource source, uint8_t channel, uint16_t position);
+
+    /**
+     * Resolves every servo to its highest-priority live claim and emits
+     * the winning (possibly crossfaded) targets into the TX queue. Call
+     * once per motion tick, before ServoTxQueue::service().
+     * @param now Current time in milliseconds
+     */
+    void resolve(unsigned long now);
+
+    /**
+     * @param channel The servo channel
+     * @return The source currently owning the servo, or ARB_SOURCE_COUNT
+     *         if no claim is live
+     */
+    ArbiterSource ownerOf(uint8_t channel) const;
+
+private:
+    struct Claim {
+        uint16_t position;
+        unsigned long stampMs;
+        bool valid;
+    };
+
+    ServoTxQueue &txQueue_;
+    Claim claims_[ARB_SOURCE_COUNT][NUM_SERVOS];
+
+    // Per-servo resolution state
+    int8_t winner_[NUM_SERVOS];          // Last winning source, -1 = none
+    uint16_t lastOutput_[NUM_SERVOS];    // Last emitted target
+    bool haveOutput_[NUM_SERVOS];
+    uint16_t fadeFrom_[NUM_SERVOS];      // Crossfade origin on owner change
+    unsigned long fadeStart_[NUM_SERVOS];
+    bool fading_[NUM_SERVOS];
+};
+
+#endif // SERVO_ARBITER_H
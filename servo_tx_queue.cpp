@@ -0,0 +1,132 @@
+#include "servo_tx_queue.h"
+
+#include <Arduino.h>
+
+// =============================================================================
+// NON-BLOCKING SERVO TX QUEUE IMPLEMENTATION
+// =============================================================================
+
+// Pololu compact protocol command bytes (same framing as MaestroBatch)
+static const uint8_t MAESTRO_CMD_SET_TARGET = 0x84;
+static const uint8_t MAESTRO_CMD_SET_MULTIPLE_TARGETS = 0x9F;
+
+ServoTxQueue::ServoTxQueue(HardwareSerial &serial) : serial_(serial) {
+    for (int i = 0; i < NUM_SERVOS; i++) {
+        targets_[i] = 0;
+        dirty_[i] = false;
+        lastSent_[i] = 0;
+        lastSentMs_[i] = 0;
+        hasSent_[i] = false;
+    }
+}
+
+void ServoTxQueue::enqueueTarget(uint8_t channel, uint16_t target) {
+    if (channel >= NUM_SERVOS) {
+        return;
+    }
+    // Delta suppression against the shadow of the last transmitted target:
+    // the jaw oscillator and eased interpolation produce long runs of
+    // near-identical positions, and the Maestro holds its last target on
+    // its own, so sub-deadband updates are pure UART waste. A target
+    // already staged (dirty) is always allowed to be overwritten, since
+    // it passed the deadband check when it was staged.
+    if (!dirty_[channel] && hasSent_[channel]) {
+        uint16_t prev = lastSent_[channel];
+        uint16_t delta = (target > prev) ? (target - prev) : (prev - target);
+        if (delta < SERVO_DEADBAND_QUARTER_US) {
+            return;
+        }
+    }
+    targets_[channel] = target;
+    dirty_[channel] = true;
+}
+
+bool ServoTxQueue::lastSentTarget(uint8_t channel, uint16_t* target,
+                                  unsigned long* sentAtMs) const {
+    if (channel >= NUM_SERVOS || !hasSent_[channel]) {
+        return false;
+    }
+    if (target != nullptr) {
+        *target = lastSent_[channel];
+    }
+    if (sentAtMs != nullptr) {
+        *sentAtMs = lastSentMs_[channel];
+    }
+    return true;
+}
+
+bool ServoTxQueue::hasPending() const {
+    for (int i = 0; i < NUM_SERVOS; i++) {
+        if (dirty_[i]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void ServoTxQueue::service() {
+    // Snapshot the dirty set and find its span
+    int first = -1;
+    int last = -1;
+    int count = 0;
+    for (int i = 0; i < NUM_SERVOS; i++) {
+        if (dirty_[i]) {
+            if (first < 0) first = i;
+            last = i;
+            count++;
+        }
+    }
+
+    if (count == 0) {
+        return;
+    }
+
+    unsigned long now = millis();
+
+    if (count > 1 && count == (last - first + 1)) {
+        // Contiguous run: one multi-target frame, if the hardware buffer
+        // can take all of it without blocking
+        int frameLen = 3 + 2 * count;
+        if (serial_.availableForWrite() < frameLen) {
+            return; // Try again next tick; targets keep coalescing
+        }
+
+        uint8_t frame[3 + 2 * NUM_SERVOS];
+        int n = 0;
+        frame[n++] = MAESTRO_CMD_SET_MULTIPLE_TARGETS;
+        frame[n++] = (uint8_t)count;
+        frame[n++] = (uint8_t)first;
+        for (int i = first; i <= last; i++) {
+            uint16_t target = targets_[i];
+            frame[n++] = target & 0x7F;
+            frame[n++] = (target >> 7) & 0x7F;
+            dirty_[i] = false;
+            lastSent_[i] = target;
+            lastSentMs_[i] = now;
+            hasSent_[i] = true;
+        }
+        serial_.write(frame, n);
+    } else {
+        // Sparse channels: individual frames, each gated on buffer space
+        for (int i = 0; i < NUM_SERVOS; i++) {
+            if (!dirty_[i]) {
+                continue;
+            }
+            if (serial_.availableForWrite() < 4) {
+                return; // Remaining channels go next tick
+            }
+            uint16_t target = targets_[i];
+            uint8_t frame[4] = {
+                MAESTRO_CMD_SET_TARGET,
+                (uint8_t)i,
+                (uint8_t)(target & 0x7F),
+                (uint8_t)((target >> 7) & 0x7F)
+            };
+            dirty_[i] = false;
+            lastSent_[i] = target;
+            lastSentMs_[i] = now;
+            hasSent_[i] = true;
+            serial_.write(frame, sizeof(frame));
+        }
+    }
+}
@@ -0,0 +1,71 @@
+#ifndef SERVO_TX_QUEUE_H
+#define SERVO_TX_QUEUE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <HardwareSerial.h>
+#include "config.h"
+
+// =============================================================================
+// NON-BLOCKING SERVO TX QUEUE
+// =============================================================================
+//
+// Sits in front of maestroSerial so the motion task never blocks on UART
+// backpressure. Targets are enqueued into per-channel slots in microseconds;
+// service() drains them into Maestro frames only when the interrupt-driven
+// hardware TX buffer has room (checked with availableForWrite), so the
+// worst-case cost per tick is bounded.
+//
+// Targets coalesce: if the jaw oscillator produces several positions before
+// the UART drains, only the newest target per channel is ever transmitted.
+
+class ServoTxQueue {
+public:
+    explicit ServoTxQueue(HardwareSerial &serial);
+
+    /**
+     * Stages the newest target for a channel. Overwrites any not-yet-sent
+     * target for the same channel (coalescing). Targets within
+     * SERVO_DEADBAND_QUARTER_US of the last transmitted position are
+     * suppressed entirely (the servo is already there). Never blocks.
+     * @param channel The servo channel (0 .. NUM_SERVOS-1)
+     * @param target Target position in quarter-microseconds
+     */
+    void enqueueTarget(uint8_t channel, uint16_t target);
+
+    /**
+     * Last target actually transmitted for a channel (the shadow state).
+     * @param channel The servo channel
+     * @param target Receives the last transmitted target
+     * @param sentAtMs Optional; receives the millis() time it was sent
+     * @return false if nothing has been transmitted on the channel yet
+     */
+    bool lastSentTarget(uint8_t channel, uint16_t* target,
+                        unsigned long* sentAtMs = nullptr) const;
+
+    /**
+     * Drains staged targets into the UART hardware buffer. Contiguous dirty
+     * channels go out as one multi-target frame. Writes nothing if the
+     * hardware buffer lacks space for a whole frame; targets simply stay
+     * staged (and keep coalescing) until the next call.
+     */
+    void service();
+
+    /**
+     * @return true if any staged target has not yet been handed to the UART
+     */
+    bool hasPending() const;
+
+private:
+    HardwareSerial &serial_;
+    volatile uint16_t targets_[NUM_SERVOS];
+    volatile bool dirty_[NUM_SERVOS];
+
+    // Shadow of what each channel was last commanded to, for delta
+    // suppression and telemetry
+    uint16_t lastSent_[NUM_SERVOS];
+    unsigned long lastSentMs_[NUM_SERVOS];
+    bool hasSent_[NUM_SERVOS];
+};
+
+#endif // SERVO_TX_QUEUE_H
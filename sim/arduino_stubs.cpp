@@ -0,0 +1,43 @@
+#include <Arduino.h>
+#include <LittleFS.h>
+
+// =============================================================================
+// SIM STUB IMPLEMENTATIONS
+// =============================================================================
+
+// Simulated clock, advanced by the harness one motion tick at a time
+unsigned long simNowMs = 0;
+
+SimSerial Serial;
+LittleFSStub LittleFS;
+
+// Deterministic xorshift32 PRNG: the same seed replays the same soak run
+// exactly, which is what makes a sim-found glitch debuggable
+static uint32_t prngState = 0x2545F491;
+
+void randomSeed(unsigned long seed) {
+    prngState = (uint32_t)seed ? (uint32_t)seed : 0x2545F491;
+}
+
+static uint32_t prngNext() {
+    uint32_t x = prngState;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    prngState = x;
+    return x;
+}
+
+long random(long maxExclusive) {
+    if (maxExclusive <= 0) {
+        return 0;
+    }
+    return (long)(prngNext() % (uint32_t)maxExclusive);
+}
+
+long random(long minInclusive, long maxExclusive) {
+    if (maxExclusive <= minInclusive) {
+        return minInclusive;
+    }
+    return minInclusive + random(maxExclusive - minInclusive);
+}
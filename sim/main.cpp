@@ -0,0 +1,192 @@
+#include <Arduino.h>
+#include <pgmspace.h>
+
+#include <stdlib.h>
+#include <time.h>
+
+#include "config.h"
+#include "motion_modes.h"
+#include "sequence_engine.h"
+#include "servo_tx_queue.h"
+#include "servo_arbiter.h"
+#include "talk_envelope.h"
+#include "synced_clock.h"
+#include "scheduler.h"
+#include "loop_budget.h"
+#include "profiler.h"
+#include "ui_events.h"
+
+// =============================================================================
+// HOST-SIDE SOAK HARNESS
+// =============================================================================
+//
+// Runs the motion mode handlers against simulated time: each iteration is
+// one motion tick, and the clock advances MOTION_TASK_PERIOD_MS per
+// iteration regardless of wall time, so an hour of show runs in well under
+// a second. The run cycles through the operation modes (scripted playback,
+// dynamic movement, dynamic + procedural talking, dynamic + envelope
+// stream) and prints traffic/profiler summaries at the end.
+//
+//   ./bones_sim [simulated-seconds] [seed]
+//
+// The PRNG is deterministic, so a given (duration, seed) pair replays the
+// identical run under perf, valgrind, or a debugger.
+
+// The objects the handlers collaborate with (the sketch defines these on
+// the device; see motion_modes.h)
+HardwareSerial maestroSerial(2);
+ServoTxQueue servoTxQueue(maestroSerial);
+ServoArbiter servoArbiter(servoTxQueue);
+TalkEnvelope talkEnvelope;
+SyncedClock syncedClock;
+SequenceEngine sequenceEngine;
+EventScheduler motionScheduler;
+ScheduledEvent dynamicMoveEvent;
+LoopBudget motionBudget(MOTION_TICK_BUDGET_US);
+
+// -----------------------------------------------------------------------------
+// UI event stubs: the render core does not exist here, so eye/blink
+// requests are just counted
+// -----------------------------------------------------------------------------
+
+static unsigned long eyeMoveRequests = 0;
+static unsigned long blinkRequests = 0;
+
+bool uiEventsInit() { return true; }
+
+bool requestEyeMove(int16_t, int16_t, uint32_t) {
+    eyeMoveRequests++;
+    return true;
+}
+
+bool requestBlink() {
+    blinkRequests++;
+    return true;
+}
+
+bool uiEventPop(UiEvent*) { return false; }
+
+// -----------------------------------------------------------------------------
+// Built-in test sequence (mirrors the sketch's fallback show)
+// -----------------------------------------------------------------------------
+
+constexpr PackedKeyframe PROGMEM sequence[] = {
+  {   0, {PAN_CENTER, NOD_CENTER, JAW_CLOSED}, EYE_H_CENTER, EYE_V_CENTER },
+  { 500, {PAN_LEFT,   NOD_CENTER, JAW_CLOSED}, EYE_H_LEFT,   EYE_V_CENTER },
+  {1500, {PAN_RIGHT,  NOD_CENTER, JAW_CLOSED}, EYE_H_RIGHT,  EYE_V_CENTER },
+  {2500, {PAN_CENTER, NOD_CENTER, JAW_CLOSED}, EYE_H_CENTER, EYE_V_CENTER },
+  {3000, {PAN_CENTER, NOD_DOWN,   JAW_CLOSED}, EYE_H_CENTER, EYE_V_DOWN   },
+  {4000, {PAN_CENTER, NOD_UP,     JAW_CLOSED}, EYE_H_CENTER, EYE_V_UP     },
+  {5000, {PAN_CENTER, NOD_CENTER, JAW_CLOSED}, EYE_H_CENTER, EYE_V_CENTER },
+  {5500, {PAN_CENTER, NOD_CENTER, JAW_OPEN}  , EYE_H_CENTER, EYE_V_CENTER },
+  {6000, {PAN_CENTER, NOD_CENTER, JAW_CLOSED}, EYE_H_CENTER, EYE_V_CENTER },
+  {6500, {PAN_CENTER, NOD_CENTER, JAW_OPEN}  , EYE_H_CENTER, EYE_V_CENTER },
+  {7000, {PAN_CENTER, NOD_CENTER, JAW_CLOSED}, EYE_H_CENTER, EYE_V_CENTER }
+};
+const int NUM_KEYFRAMES = sizeof(sequence) / sizeof(PackedKeyframe);
+
+static_assert(sequenceValid(sequence, NUM_KEYFRAMES),
+              "sim test sequence has an out-of-range or out-of-order keyframe");
+
+// -----------------------------------------------------------------------------
+// Mode phase script: 30 s per phase, cycling forever
+// -----------------------------------------------------------------------------
+
+enum SoakPhase { PHASE_SCRIPTED, PHASE_DYNAMIC, PHASE_TALKING, PHASE_ENVELOPE,
+                 PHASE_COUNT };
+static const unsigned long PHASE_LENGTH_MS = 30000;
+
+static void enterPhase(SoakPhase phase) {
+    talkingStartTime = 0;
+    talkEnvelope.reset();
+    if (phase == PHASE_SCRIPTED) {
+        currentMode = OperationMode::SCRIPTED;
+        sequenceStartTime = 0;
+        sequencePausedOffset = 0;
+        return;
+    }
+    currentMode = OperationMode::DYNAMIC;
+    if (phase == PHASE_TALKING) {
+        // Procedural talking runs on top of dynamic mode
+        talkingStartTime = simNowMs;
+        talkSegmentStartTime = simNowMs;
+        currentTalkSegmentDuration = 0;
+    }
+}
+
+// Synthetic envelope traffic: one 11-sample packet per 200 ms, i.e. the
+// 50 Hz sample rate the controller streams at
+static void feedEnvelope() {
+    static uint8_t level = 0;
+    uint8_t packet[12];
+    packet[0] = level;
+    for (int i = 1; i < 12; i++) {
+        packet[i] = (uint8_t)(int8_t)random(-40, 41);
+        level = (uint8_t)(level + (int8_t)packet[i]);
+    }
+    talkEnvelope.pushPacket(packet, sizeof(packet));
+}
+
+static double wallSeconds() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+int main(int argc, char** argv) {
+    unsigned long simSeconds = (argc > 1) ? strtoul(argv[1], NULL, 10) : 600;
+    unsigned long seed = (argc > 2) ? strtoul(argv[2], NULL, 10) : 1;
+    randomSeed(seed);
+
+    initServoConfigCache();
+    loadServoCalibration();
+    sequenceEngine.begin(sequence, NUM_KEYFRAMES);
+
+    sequencePaused = false;
+    enterPhase(PHASE_SCRIPTED);
+    motionScheduler.schedule(&dynamicMoveEvent, simNowMs + 1000,
+                             dynamicMoveCallback);
+
+    printf("soaking %lu simulated seconds (seed %lu)\n", simSeconds, seed);
+
+    const unsigned long endMs = simSeconds * 1000UL;
+    unsigned long ticks = 0;
+    SoakPhase phase = PHASE_SCRIPTED;
+    unsigned long phaseStart = 0;
+    double wallStart = wallSeconds();
+
+    while (simNowMs < endMs) {
+        // Same per-tick pipeline as the device's motion task
+        if (simNowMs - phaseStart >= PHASE_LENGTH_MS) {
+            phase = (SoakPhase)((phase + 1) % PHASE_COUNT);
+            phaseStart = simNowMs;
+            enterPhase(phase);
+        }
+        if (phase == PHASE_ENVELOPE && simNowMs % 200 == 0) {
+            feedEnvelope();
+        }
+
+        motionScheduler.runDue(simNowMs);
+        if (currentMode == OperationMode::SCRIPTED) {
+            handleScriptedMode(simNowMs, false);
+        }
+        handleJawMovement(simNowMs);
+        servoArbiter.resolve(simNowMs);
+        servoTxQueue.service();
+
+        ticks++;
+        simNowMs += MOTION_TASK_PERIOD_MS;
+    }
+
+    double wallElapsed = wallSeconds() - wallStart;
+    printf("\n%lu ticks in %.3f s wall (%.0fx real time)\n",
+           ticks, wallElapsed,
+           wallElapsed > 0 ? (double)simSeconds / wallElapsed : 0.0);
+    printf("maestro traffic: %lu bytes, %lu multi/single frames\n",
+           maestroSerial.bytesWritten, maestroSerial.framesWritten);
+    printf("ui requests: %lu eye moves, %lu blinks\n",
+           eyeMoveRequests, blinkRequests);
+    printf("\n");
+    profilerDump();
+    return 0;
+}
@@ -0,0 +1,52 @@
+#ifndef SIM_STUB_ARDUINO_H
+#define SIM_STUB_ARDUINO_H
+
+// =============================================================================
+// SIM STUB: Arduino core
+// =============================================================================
+//
+// Minimal host-side replacement for the Arduino core, just enough for the
+// portable modules and the motion mode handlers. Time is fully simulated:
+// millis() reads a counter the harness advances one motion tick at a time,
+// which is what lets a soak run thousands of times faster than real time.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+// Simulated clock, advanced only by the harness (never by wall time)
+extern unsigned long simNowMs;
+
+inline unsigned long millis() { return simNowMs; }
+inline unsigned long micros() { return simNowMs * 1000UL; }
+inline void delay(unsigned long) {}
+
+/** Seeds the deterministic PRNG backing random(). */
+void randomSeed(unsigned long seed);
+
+/** Arduino-compatible random: returns a value in [0, maxExclusive). */
+long random(long maxExclusive);
+
+/** Arduino-compatible random: returns a value in [minInclusive, maxExclusive). */
+long random(long minInclusive, long maxExclusive);
+
+// Serial facade printing to stdout, covering the overloads the modules use
+class SimSerial {
+public:
+    void print(const char* s) { fputs(s, stdout); }
+    void print(char c) { fputc(c, stdout); }
+    void print(int v) { printf("%d", v); }
+    void print(unsigned int v) { printf("%u", v); }
+    void print(long v) { printf("%ld", v); }
+    void print(unsigned long v) { printf("%lu", v); }
+    void println() { fputc('\n', stdout); }
+    void println(const char* s) { puts(s); }
+    void println(int v) { printf("%d\n", v); }
+    void println(unsigned int v) { printf("%u\n", v); }
+    void println(long v) { printf("%ld\n", v); }
+    void println(unsigned long v) { printf("%lu\n", v); }
+};
+extern SimSerial Serial;
+
+#endif // SIM_STUB_ARDUINO_H
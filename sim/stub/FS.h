@@ -0,0 +1,29 @@
+#ifndef SIM_STUB_FS_H
+#define SIM_STUB_FS_H
+
+// =============================================================================
+// SIM STUB: FS (filesystem types)
+// =============================================================================
+//
+// A File that is never open: the sequence engine's file-backed path always
+// falls through to the built-in sequence in the sim (LittleFS.begin()
+// returns false). Uploaded-show soak tests on the host are future work.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <Arduino.h> // The real FS.h pulls in the core too (Serial, String)
+
+namespace fs {
+
+class File {
+public:
+    operator bool() const { return false; }
+    void close() {}
+    size_t read(uint8_t*, size_t) { return 0; }
+    bool seek(size_t) { return false; }
+    size_t size() const { return 0; }
+};
+
+} // namespace fs
+
+#endif // SIM_STUB_FS_H
@@ -0,0 +1,39 @@
+#ifndef SIM_STUB_HARDWARESERIAL_H
+#define SIM_STUB_HARDWARESERIAL_H
+
+// =============================================================================
+// SIM STUB: HardwareSerial (Maestro UART)
+// =============================================================================
+//
+// Counts the bytes and frames the servo TX queue emits instead of driving a
+// UART, so a soak run can assert on wire traffic (e.g. that the deadband
+// and coalescing actually bound the byte rate).
+
+#include <stdint.h>
+#include <stddef.h>
+
+class HardwareSerial {
+public:
+    explicit HardwareSerial(int) {}
+
+    // Always reports room: the sim has no UART backpressure. (A future
+    // experiment can model a drained-per-tick buffer here.)
+    int availableForWrite() const { return 128; }
+
+    size_t write(uint8_t) {
+        bytesWritten++;
+        return 1;
+    }
+
+    size_t write(const uint8_t*, size_t len) {
+        bytesWritten += len;
+        framesWritten++;
+        return len;
+    }
+
+    // Harness-visible traffic counters
+    unsigned long bytesWritten = 0;
+    unsigned long framesWritten = 0;
+};
+
+#endif // SIM_STUB_HARDWARESERIAL_H
@@ -0,0 +1,20 @@
+#ifndef SIM_STUB_LITTLEFS_H
+#define SIM_STUB_LITTLEFS_H
+
+// =============================================================================
+// SIM STUB: LittleFS
+// =============================================================================
+
+#include <FS.h>
+
+class LittleFSStub {
+public:
+    bool begin(bool) { return false; } // No filesystem on the host
+    fs::File open(const char*, const char*) { return fs::File(); }
+    bool remove(const char*) { return false; }
+    bool rename(const char*, const char*) { return false; }
+};
+
+extern LittleFSStub LittleFS;
+
+#endif // SIM_STUB_LITTLEFS_H
@@ -0,0 +1,22 @@
+#ifndef SIM_STUB_PREFERENCES_H
+#define SIM_STUB_PREFERENCES_H
+
+// =============================================================================
+// SIM STUB: Preferences (NVS)
+// =============================================================================
+//
+// No persistence on the host: calibration loads report "nothing stored",
+// so the sim always runs on the PROGMEM default servo tables.
+
+#include <stddef.h>
+
+class Preferences {
+public:
+    bool begin(const char*, bool) { return false; }
+    void end() {}
+    size_t getBytes(const char*, void*, size_t) { return 0; }
+    size_t putBytes(const char*, const void*, size_t len) { return len; }
+    bool remove(const char*) { return true; }
+};
+
+#endif // SIM_STUB_PREFERENCES_H
@@ -0,0 +1,22 @@
+#ifndef SIM_STUB_ESP_CPU_H
+#define SIM_STUB_ESP_CPU_H
+
+// =============================================================================
+// SIM STUB: esp_cpu (cycle counter)
+// =============================================================================
+//
+// Maps the cycle counter onto the host's monotonic clock scaled to the
+// device's 240 MHz, so the profiler's relative numbers stay meaningful
+// (they measure host cost, which is what perf/valgrind runs care about).
+
+#include <stdint.h>
+#include <time.h>
+
+inline uint32_t esp_cpu_get_cycle_count() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 240000000ULL
+                      + (uint64_t)ts.tv_nsec * 240ULL / 1000ULL);
+}
+
+#endif // SIM_STUB_ESP_CPU_H
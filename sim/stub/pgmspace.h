@@ -0,0 +1,28 @@
+#ifndef SIM_STUB_PGMSPACE_H
+#define SIM_STUB_PGMSPACE_H
+
+// =============================================================================
+// SIM STUB: pgmspace
+// =============================================================================
+//
+// On the host there is no flash/RAM split, so PROGMEM data is ordinary data
+// and every accessor degenerates to a plain read (same as the ESP32 core's
+// own pgmspace.h, which is also a compatibility shim).
+
+#include <stdint.h>
+#include <string.h>
+#include <strings.h>
+
+#define PROGMEM
+#define PSTR(s) (s)
+typedef const char* PGM_P;
+
+#define pgm_read_byte(addr)  (*(const uint8_t*)(addr))
+#define pgm_read_word(addr)  (*(const uint16_t*)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t*)(addr))
+
+#define memcpy_P memcpy
+#define strlen_P strlen
+#define strncasecmp_P strncasecmp
+
+#endif // SIM_STUB_PGMSPACE_H
@@ -0,0 +1,53 @@
+#include "synced_clock.h"
+
+// =============================================================================
+// SYNCED SHOW CLOCK IMPLEMENTATION
+// =============================================================================
+
+SyncedClock::SyncedClock()
+    : offsetMs_(0), slewResidualQ8_(0), haveOffset_(false), lastBeaconMs_(0) {
+}
+
+void SyncedClock::discipline(unsigned long localMs, uint32_t masterMs) {
+    // Mod-2^32 signed difference: correct for any skew up to +/-2^31 ms,
+    // so a freshly booted skull syncing against a controller that has been
+    // up for hours measures the real offset instead of overflowing
+    int32_t measuredMs = (int32_t)(masterMs - (uint32_t)localMs);
+
+    if (!haveOffset_) {
+        offsetMs_ = measuredMs;
+        slewResidualQ8_ = 0;
+        haveOffset_ = true;
+    } else {
+        int32_t errorMs = measuredMs - offsetMs_;
+        if (errorMs > SYNC_STEP_THRESHOLD_MS || errorMs < -SYNC_STEP_THRESHOLD_MS) {
+            // Gross error (reboot, long outage): step, don't slew
+            offsetMs_ = measuredMs;
+            slewResidualQ8_ = 0;
+        } else {
+            // Small error: slew toward the measurement, averaging out BLE
+            // delivery jitter across beacons. Only this bounded error term
+            // is ever in Q8 (|errorMs| <= the step threshold), with the
+            // sub-millisecond part accumulating in the residual until it
+            // carries into a whole millisecond.
+            slewResidualQ8_ += (errorMs * 256) >> SYNC_EWMA_SHIFT;
+            int32_t carryMs = slewResidualQ8_ >> 8;
+            offsetMs_ += carryMs;
+            slewResidualQ8_ -= carryMs * 256;
+        }
+    }
+    lastBeaconMs_ = localMs;
+}
+
+unsigned long SyncedClock::now(unsigned long localMs) const {
+    return localMs + (unsigned long)(long)offsetMs_;
+}
+
+bool SyncedClock::synced(unsigned long localMs) const {
+    return haveOffset_ &&
+           (unsigned long)(localMs - lastBeaconMs_) < SYNC_VALID_TIMEOUT_MS;
+}
+
+long SyncedClock::offsetMs() const {
+    return (long)offsetMs_;
+}
@@ -0,0 +1,67 @@
+#ifndef SYNCED_CLOCK_H
+#define SYNCED_CLOCK_H
+
+#include <stdint.h>
+#include "config.h"
+
+// =============================================================================
+// SYNCED SHOW CLOCK (MULTI-SKULL TIMEBASE)
+// =============================================================================
+//
+// Disciplines a shared show timebase across skulls so a scripted sequence
+// plays in lockstep on all of them. The controller (or a designated master
+// skull relaying through it) periodically sends a `sync <masterMs>` beacon
+// to every skull; each skull tracks the offset between that master clock
+// and its local millis() with an EWMA, which averages out BLE delivery
+// jitter and compensates crystal drift for as long as beacons keep coming.
+//
+// Large errors (a reboot, the first beacon) step the offset immediately;
+// small errors slew at 1/2^SYNC_EWMA_SHIFT per beacon so show time never
+// jumps visibly mid-performance. With no beacon the clock degrades
+// gracefully to plain local time plus the last known offset.
+
+class SyncedClock {
+public:
+    SyncedClock();
+
+    /**
+     * Applies one timebase beacon.
+     * @param localMs Local millis() when the beacon was processed
+     * @param masterMs Master show time carried by the beacon
+     */
+    void discipline(unsigned long localMs, uint32_t masterMs);
+
+    /**
+     * Converts local time to show time using the disciplined offset.
+     * Identity (offset 0) until the first beacon arrives.
+     * @param localMs Local millis()
+     * @return Show time in milliseconds
+     */
+    unsigned long now(unsigned long localMs) const;
+
+    /**
+     * @param localMs Local millis()
+     * @return true if a beacon arrived within SYNC_VALID_TIMEOUT_MS
+     */
+    bool synced(unsigned long localMs) const;
+
+    /**
+     * @return Current master-minus-local offset in milliseconds
+     */
+    long offsetMs() const;
+
+private:
+    // Whole-millisecond offset (master minus local, mod-2^32 signed), so
+    // an arbitrarily large skew -- a fresh boot syncing against a
+    // long-running controller -- never overflows; written by the motion
+    // task, read by status reporting. The EWMA's sub-millisecond precision
+    // lives in slewResidualQ8_, which only ever holds the bounded
+    // below-step-threshold error term and is touched by the motion task
+    // alone.
+    volatile int32_t offsetMs_;
+    int32_t slewResidualQ8_;
+    volatile bool haveOffset_;
+    volatile unsigned long lastBeaconMs_;
+};
+
+#endif // SYNCED_CLOCK_H
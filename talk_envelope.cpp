@@ -0,0 +1,79 @@
+#include "talk_envelope.h"
+
+#include <Arduino.h>
+
+// =============================================================================
+// STREAMED TALKING ENVELOPE IMPLEMENTATION
+// =============================================================================
+
+TalkEnvelope::TalkEnvelope()
+    : head_(0), tail_(0), dropped_(0), anchored_(false), epochMs_(0),
+      playIndex_(0), lastOpenness_(0), lastDataMs_(0) {
+}
+
+void TalkEnvelope::pushPacket(const uint8_t* data, size_t len) {
+    if (data == nullptr || len < 1) {
+        return;
+    }
+
+    // Decode: absolute first sample, then signed deltas, clamped to 0..255
+    // so a corrupt delta can never wrap the jaw from open to closed
+    int level = data[0];
+    for (size_t i = 0; i < len; i++) {
+        if (i > 0) {
+            level += (int8_t)data[i];
+            if (level < 0) level = 0;
+            if (level > 255) level = 255;
+        }
+        if ((uint16_t)(head_ - tail_) >= RING_SAMPLES) {
+            dropped_++;
+            continue; // Ring full: controller is streaming too far ahead
+        }
+        samples_[head_ & RING_MASK] = (uint8_t)level;
+        head_ = head_ + 1;
+    }
+    lastDataMs_ = millis();
+}
+
+bool TalkEnvelope::sample(unsigned long now, uint8_t* openness) {
+    // Anchor the playback clock once enough samples are buffered to absorb
+    // BLE arrival jitter; until then the stream is not live
+    if (!anchored_) {
+        if ((uint16_t)(head_ - tail_) < ENVELOPE_PREFILL_SAMPLES) {
+            return false;
+        }
+        anchored_ = true;
+        epochMs_ = now;
+        playIndex_ = 0;
+    }
+
+    // Consume every sample whose deadline has passed, keeping only the
+    // newest: the motion task ticks faster than the sample rate, and a
+    // late wakeup skips samples instead of replaying them in a burst
+    uint32_t due = (uint32_t)(now - epochMs_) / ENVELOPE_SAMPLE_PERIOD_MS;
+    while (playIndex_ <= due && tail_ != head_) {
+        lastOpenness_ = samples_[tail_ & RING_MASK];
+        tail_ = tail_ + 1;
+        playIndex_++;
+    }
+
+    // Starved: playback caught up with the producer. Hold the last sample
+    // briefly (a controller hiccup), then hand the jaw back to the
+    // procedural oscillator
+    if (tail_ == head_ && playIndex_ <= due) {
+        if ((unsigned long)(now - lastDataMs_) > ENVELOPE_STARVE_TIMEOUT_MS) {
+            anchored_ = false;
+            return false;
+        }
+    }
+
+    *openness = lastOpenness_;
+    return true;
+}
+
+void TalkEnvelope::reset() {
+    tail_ = head_;
+    anchored_ = false;
+    playIndex_ = 0;
+    lastOpenness_ = 0;
+}
@@ -0,0 +1,89 @@
+#ifndef TALK_ENVELOPE_H
+#define TALK_ENVELOPE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "config.h"
+
+// =============================================================================
+// STREAMED TALKING ENVELOPE (VISEME / ENERGY PLAYBACK)
+// =============================================================================
+//
+// Real lip sync: the controller extracts an 8-bit jaw-openness envelope from
+// its TTS audio and streams it over a dedicated BLE characteristic as
+// delta-encoded packets at ENVELOPE_SAMPLE_RATE_HZ. Samples land in a
+// lock-free SPSC ring (BLE callback produces, motion task consumes) and are
+// played out against a local clock anchored when the ring first reaches a
+// prefill level, so BLE arrival jitter is absorbed by the buffer rather
+// than showing up on the jaw.
+//
+// Packet format (write-without-response, up to one MTU per packet):
+//   byte 0      absolute openness of the first sample (0 = closed, 255 = open)
+//   bytes 1..n  signed int8 delta from the previous sample
+//
+// Each packet re-anchors the absolute level, so a lost packet causes at
+// most one packet's worth of drift. When the stream starves for longer
+// than ENVELOPE_STARVE_TIMEOUT_MS the engine deactivates and
+// handleJawMovement() falls back to the procedural sine oscillator.
+
+class TalkEnvelope {
+public:
+    TalkEnvelope();
+
+    /**
+     * Decodes one delta-encoded packet into the sample ring. Producer side;
+     * called from the BLE write callback. Samples that do not fit are
+     * dropped (and counted) rather than blocking the BLE stack.
+     * @param data Raw packet bytes (absolute first sample + int8 deltas)
+     * @param len Packet length in bytes; must be >= 1
+     */
+    void pushPacket(const uint8_t* data, size_t len);
+
+    /**
+     * Samples the envelope at the given time. Consumer side; called from
+     * the motion task. Advances the playback clock, discarding samples
+     * whose deadline has passed (jitter absorption, no catch-up bursts).
+     * @param now Current time in milliseconds
+     * @param openness Receives the jaw openness (0 = closed, 255 = open)
+     * @return true if the stream is live and openness is valid; false when
+     *         idle or starved (caller should fall back to the oscillator)
+     */
+    bool sample(unsigned long now, uint8_t* openness);
+
+    /**
+     * @return true if envelope samples are currently driving the jaw
+     */
+    bool active() const { return anchored_; }
+
+    /**
+     * Discards all buffered samples and drops the playback anchor.
+     * Called when talking stops.
+     */
+    void reset();
+
+    /**
+     * @return Number of samples dropped because the ring was full
+     */
+    uint32_t dropped() const { return dropped_; }
+
+private:
+    // Ring capacity in samples; power of two, ~5 s at 50 Hz
+    static const uint16_t RING_SAMPLES = 256;
+    static const uint16_t RING_MASK = RING_SAMPLES - 1;
+    static_assert((RING_SAMPLES & RING_MASK) == 0,
+                  "RING_SAMPLES must be a power of two");
+
+    uint8_t samples_[RING_SAMPLES];
+    volatile uint16_t head_;    // Next slot to write (producer-owned)
+    volatile uint16_t tail_;    // Next slot to read (consumer-owned)
+    volatile uint32_t dropped_;
+
+    // Read cross-core by the render loop via active()
+    volatile bool anchored_;    // Playback clock is running
+    unsigned long epochMs_;     // Time sample index 0 of this run plays
+    uint32_t playIndex_;        // Samples consumed since epoch
+    uint8_t lastOpenness_;      // Held while waiting for the next deadline
+    unsigned long lastDataMs_;  // For starve detection
+};
+
+#endif // TALK_ENVELOPE_H
@@ -0,0 +1,55 @@
+#include "telemetry.h"
+
+#include <string.h>
+
+// =============================================================================
+// PUSH TELEMETRY STREAM IMPLEMENTATION
+// =============================================================================
+
+TelemetryGate::TelemetryGate() : lastSendMs_(0), haveSent_(false) {
+    memset(&lastSent_, 0, sizeof(lastSent_));
+}
+
+static uint16_t absDiffU16(uint16_t a, uint16_t b) {
+    return (a > b) ? (a - b) : (b - a);
+}
+
+bool TelemetryGate::shouldSend(const TelemetryPacket& packet, unsigned long now) {
+    unsigned long sinceLast = now - lastSendMs_;
+
+    if (haveSent_ && sinceLast < TELEMETRY_MIN_INTERVAL_MS) {
+        return false; // Rate limit, regardless of what changed
+    }
+
+    bool send = false;
+    if (!haveSent_ || sinceLast >= TELEMETRY_HEARTBEAT_INTERVAL_MS) {
+        send = true; // First packet, or liveness heartbeat
+    } else if (packet.mode != lastSent_.mode ||
+               packet.flags != lastSent_.flags ||
+               packet.keyframeIndex != lastSent_.keyframeIndex ||
+               packet.keyframeCount != lastSent_.keyframeCount ||
+               packet.connIntervalUnits != lastSent_.connIntervalUnits) {
+        send = true; // Discrete state: any change is news
+    } else if ((uint32_t)(packet.freeHeap > lastSent_.freeHeap
+                   ? packet.freeHeap - lastSent_.freeHeap
+                   : lastSent_.freeHeap - packet.freeHeap) >= TELEMETRY_HEAP_THRESHOLD_BYTES ||
+               absDiffU16(packet.motionTickUs, lastSent_.motionTickUs)
+                   >= TELEMETRY_TICK_THRESHOLD_US) {
+        send = true;
+    } else {
+        for (int i = 0; i < NUM_SERVOS; i++) {
+            if (absDiffU16(packet.servoTargets[i], lastSent_.servoTargets[i])
+                    >= TELEMETRY_SERVO_THRESHOLD) {
+                send = true;
+                break;
+            }
+        }
+    }
+
+    if (send) {
+        lastSent_ = packet;
+        lastSendMs_ = now;
+        haveSent_ = true;
+    }
+    return send;
+}
@@ -0,0 +1,64 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <stdint.h>
+#include "config.h"
+
+// =============================================================================
+// PUSH TELEMETRY STREAM
+// =============================================================================
+//
+// Replaces controller-side `status` polling with change-driven notifies on
+// a dedicated characteristic. The motion task builds a packed snapshot
+// every tick and the gate below decides whether it is worth airtime:
+// notifies go out when a discrete field changes or an analog field moves
+// beyond its threshold, rate-limited to one per TELEMETRY_MIN_INTERVAL_MS,
+// with a heartbeat at TELEMETRY_HEARTBEAT_INTERVAL_MS so the controller
+// can tell a quiet skull from a dead one. Reaction to sequence completion
+// drops from the old 500 ms poll interval to a single notify.
+
+// Packet layout (little-endian, packed). Version first so the controller
+// can reject a layout it doesn't understand.
+struct __attribute__((packed)) TelemetryPacket {
+    uint8_t version;                    // TELEMETRY_VERSION
+    uint8_t mode;                       // OperationMode as uint8
+    uint8_t flags;                      // TELEMETRY_FLAG_* bits
+    uint8_t reserved;
+    uint16_t keyframeIndex;             // Sequence cursor
+    uint16_t keyframeCount;             // Active sequence length
+    uint16_t servoTargets[NUM_SERVOS];  // Last transmitted targets
+    uint16_t motionTickUs;              // Last motion tick's work time
+    uint32_t freeHeap;                  // Internal heap, bytes
+    uint16_t connIntervalUnits;         // Requested conn interval (1.25 ms
+                                        // units; 0 = central's default)
+};
+
+const uint8_t TELEMETRY_VERSION = 2;
+
+const uint8_t TELEMETRY_FLAG_TALKING = 0x01;
+const uint8_t TELEMETRY_FLAG_PAUSED  = 0x02;
+const uint8_t TELEMETRY_FLAG_IDLE    = 0x04;
+const uint8_t TELEMETRY_FLAG_SYNCED  = 0x08;
+
+class TelemetryGate {
+public:
+    TelemetryGate();
+
+    /**
+     * Decides whether a snapshot differs enough from the last one sent to
+     * be worth a notify. Discrete fields (mode, flags, keyframe index)
+     * trigger on any change; analog fields only beyond their thresholds.
+     * A true return records the snapshot as sent.
+     * @param packet The candidate snapshot
+     * @param now Current time in milliseconds
+     * @return true if the caller should notify this packet
+     */
+    bool shouldSend(const TelemetryPacket& packet, unsigned long now);
+
+private:
+    TelemetryPacket lastSent_;
+    unsigned long lastSendMs_;
+    bool haveSent_;
+};
+
+#endif // TELEMETRY_H
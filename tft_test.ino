@@ -3,10 +3,6 @@
 
 #include <lvgl.h>
 
-#if LV_USE_TFT_ESPI
-#include <TFT_eSPI.h>
-#endif
-
 #include <HardwareSerial.h>
 #include <PololuMaestro.h>
 #include <BLEDevice.h>
@@ -17,23 +13,92 @@
 #include <pgmspace.h>
 #include <string.h>
 #include "config.h"
+#include "ui_events.h"
+#include "display_flush.h"
+#include "maestro_batch.h"
+#include "servo_tx_queue.h"
+#include "servo_arbiter.h"
+#include "sequence_engine.h"
+#include "motion_modes.h"
+#include "command_ring.h"
+#include "talk_envelope.h"
+#include "sequence_upload.h"
+#include "ota_update.h"
+#include "conn_params.h"
+#include "synced_clock.h"
+#include "telemetry.h"
+#include "loop_budget.h"
+#include "scheduler.h"
+#include "profiler.h"
+#ifdef RUN_BENCHMARKS
+#include "benchmark.h"
+#endif
 
 HardwareSerial maestroSerial(2);
 MiniMaestro maestro(maestroSerial);
+ServoTxQueue servoTxQueue(maestroSerial);
+MaestroBatch maestroBatch(servoTxQueue);
+// Every animation source stages targets here; one resolve per motion tick
+// emits a single winner per servo into the TX queue
+ServoArbiter servoArbiter(servoTxQueue);
 
 // See the following for generating UUIDs:
 // https://www.uuidgenerator.net/
 #define SERVICE_UUID        "0b3a2666-6f1a-4262-9d6d-563a3d6a5867"
 #define COMMAND_CHARACTERISTIC_UUID "a5228043-8350-4d13-9842-11a050d7896c"
 #define RESPONSE_CHARACTERISTIC_UUID "1ea38cd0-6856-4f15-970a-3931b3b4a83d"
+#define ENVELOPE_CHARACTERISTIC_UUID "7c4b9d12-03ae-48e9-b6a1-84f2c55d0e3b"
+#define UPLOAD_CHARACTERISTIC_UUID "3f8a6d40-91c7-4b5e-8d02-6ba7e13c9f54"
+#define TELEMETRY_CHARACTERISTIC_UUID "5d2e8f71-4a06-49c3-9b48-20cd71e6a92f"
+#define OTA_CHARACTERISTIC_UUID "9a1f3c85-72d9-4e06-b1af-58c6d2e97034"
 
 BLECharacteristic *pCommandCharacteristic;
 BLECharacteristic *pResponseCharacteristic;
-bool deviceConnected = false;
+BLECharacteristic *pEnvelopeCharacteristic;
+BLECharacteristic *pUploadCharacteristic;
+BLECharacteristic *pTelemetryCharacteristic;
+BLECharacteristic *pOtaCharacteristic;
+volatile bool deviceConnected = false;
 
 char commandBuffer[MAX_COMMAND_LENGTH];
 uint8_t commandIndex = 0;
-bool sequencePaused = true;
+// BLE writes land here and are executed later by the motion task
+CommandRing commandRing;
+// Streamed jaw-openness envelope for real lip sync (BLE produces, motion
+// task plays back)
+TalkEnvelope talkEnvelope;
+// Shared show timebase, disciplined by `sync` beacons from the controller
+// so multiple skulls play the scripted sequence in lockstep
+SyncedClock syncedClock;
+// Chunked BLE sequence upload, staged in PSRAM and committed by the
+// motion task
+SequenceUpload sequenceUpload;
+// BLE firmware updates: PSRAM-staged, background-flashed, applied at idle
+OtaUpdate otaUpdate;
+// Fast interval during command bursts, slow when the link idles
+ConnParamGovernor connParams;
+// Change-gated push telemetry (motion task publishes; see telemetry.h)
+TelemetryGate telemetryGate;
+// Work time of the last motion tick, measured for telemetry
+static uint16_t lastMotionTickUs = 0;
+
+// Per-loop work budgets: an overrun sheds optional work (interpolation,
+// telemetry, the LVGL frame) on the next iteration. Each instance is owned
+// by its loop's task; stats reads the counters cross-core, which is fine
+// for monotonically growing counts.
+LoopBudget motionBudget(MOTION_TICK_BUDGET_US);
+LoopBudget renderBudget(RENDER_FRAME_BUDGET_US);
+
+// Idle governor state: with no client and nothing playing, the render loop
+// downclocks the CPU and both loops stretch their periods. idleGoverned and
+// the activity timestamps are owned by the render loop; motionTaskIdle is
+// the one flag the motion task reads.
+static bool idleGoverned = false;
+static unsigned long lastActivityTime = 0;
+volatile bool motionTaskIdle = false;
+// LVGL's timer handler keeps running while now < uiActiveUntil, so blink
+// and eye animations complete even under the idle governor
+static unsigned long uiActiveUntil = 0;
 
 
 // Eye animation globals
@@ -42,45 +107,30 @@ static lv_obj_t * pupil;
 static int16_t current_eye_h = 0;
 static int16_t current_eye_v = 0;
 
-// Automatic blink timer
-unsigned long last_blink_time = 0;
-unsigned long next_blink_interval = 0;
-
-// Operation mode configuration
-OperationMode currentMode = OperationMode::DYNAMIC;
-
-// Dynamic mode state variables
-DynamicModeConfig dynamicConfig = DEFAULT_DYNAMIC_CONFIG;
-unsigned long lastDynamicMovement = 0;
-unsigned long nextDynamicMovement = 0;
-bool dynamicModeInitialized = false;
-
-// Talking mode state variables
-unsigned long talkingStartTime = 0;
-float currentJawSpeed = 0.0f;
-float currentJawAmplitude = 0.0f;
-bool isTalkingPaused = false;
-unsigned long pauseEndTime = 0;
-unsigned long talkSegmentStartTime = 0;
-uint32_t currentTalkSegmentDuration = 0;
-unsigned long lastTalkingHeadMovement = 0;
-unsigned long nextTalkingHeadMovement = 0;
-bool talkingModeInitialized = false;
+// Event schedulers: one timeline per task so scheduling stays lock-free.
+// Blink and advertising-retry live on the render loop; the dynamic movement
+// generator lives on the motion task.
+EventScheduler uiScheduler;
+EventScheduler motionScheduler;
+ScheduledEvent blinkEvent;
+ScheduledEvent advertisingEvent;
+ScheduledEvent dynamicMoveEvent;
+ScheduledEvent profilerDumpEvent;
 
+// Mode and playback state (currentMode, sequencePaused, talking state,
+// sequence timeline) now lives in motion_modes.cpp alongside the handlers,
+// so the same code drives the device and the sim/ harness
 
 // All constants now defined in config.h
 
 // Servo range configuration now in config.h
 
-// 2) create a simple sequence where I can specify the positions and start times of each "keyframe"
-struct Keyframe {
-  uint32_t startTime;
-  uint16_t positions[NUM_SERVOS];
-  int16_t eye_h_pos;
-  int16_t eye_v_pos;
-};
-
-const Keyframe PROGMEM sequence[] = {
+// 2) a simple built-in sequence: positions and start times of each "keyframe".
+// Used as the fallback when no uploaded show exists on LittleFS; the
+// Keyframe struct itself now lives in sequence_engine.h.
+// Packed flash form (12 bytes/keyframe); constexpr so the static_assert
+// below can prove every frame at build time
+constexpr PackedKeyframe PROGMEM sequence[] = {
   {   0, {PAN_CENTER, NOD_CENTER, JAW_CLOSED}, EYE_H_CENTER, EYE_V_CENTER },
   { 500, {PAN_LEFT,   NOD_CENTER, JAW_CLOSED}, EYE_H_LEFT,   EYE_V_CENTER },
   {1500, {PAN_RIGHT,  NOD_CENTER, JAW_CLOSED}, EYE_H_RIGHT,  EYE_V_CENTER },
@@ -93,41 +143,53 @@ const Keyframe PROGMEM sequence[] = {
   {6500, {PAN_CENTER, NOD_CENTER, JAW_OPEN}  , EYE_H_CENTER, EYE_V_CENTER },
   {7000, {PAN_CENTER, NOD_CENTER, JAW_CLOSED}, EYE_H_CENTER, EYE_V_CENTER }
 };
-const int NUM_KEYFRAMES = sizeof(sequence) / sizeof(Keyframe);
-// The total duration of the sequence is the start time of the last keyframe.
-const uint32_t sequence_duration = 7000; // Last keyframe start time
+const int NUM_KEYFRAMES = sizeof(sequence) / sizeof(PackedKeyframe);
+
+// Every authored keyframe is proven in range (servo limits, eye limits,
+// strictly increasing start times) before the firmware even links;
+// playback skips runtime validation for this source entirely
+static_assert(sequenceValid(sequence, NUM_KEYFRAMES),
+              "built-in sequence has an out-of-range or out-of-order keyframe");
 
-// for tracking playback
-unsigned long sequenceStartTime = 0;
-int nextKeyframeIndex = 0;
+// Sequence playback engine (streams uploaded shows from LittleFS, falls
+// back to the PROGMEM array above)
+SequenceEngine sequenceEngine;
 
-// Display configuration now in config.h
-uint32_t draw_buf[DRAW_BUF_SIZE / 4];
+// Display configuration now in config.h; draw buffers and the DMA flush
+// callback live in display_flush.cpp
 
 /* Global */
 static lv_grad_dsc_t SCLERA_GRADIENT;
 
-/* LVGL calls it when a rendered image needs to copied to the display*/
-void my_disp_flush( lv_display_t *disp, const lv_area_t *area, uint8_t * px_map)
-{
-    /*Copy `px map` to the `area`*/
-
-    /*For example ("my_..." functions needs to be implemented by you)
-    uint32_t w = lv_area_get_width(area);
-    uint32_t h = lv_area_get_height(area);
-
-    my_set_window(area->x1, area->y1, w, h);
-    my_draw_bitmaps(px_map, w * h);
-     */
-
-    /*Call it to tell LVGL you are ready*/
-    lv_display_flush_ready(disp);
-}
+// Sclera gradient tile cache: the radial gradient's shape never changes,
+// only its focal point translates with eye position. On modules with PSRAM
+// the gradient is rendered once at startup into an oversized tile (screen
+// size plus the maximum eye offsets) and eye motion just re-blits it at an
+// offset, eliminating per-pixel gradient math from every frame.
+static lv_obj_t * sclera_image = NULL;   // NULL when falling back to live gradient
+static uint8_t * sclera_cache_buf = NULL;
+static lv_image_dsc_t sclera_cache_dsc;
 
+#define SCLERA_CACHE_W (TFT_HOR_RES + 2 * EYE_MAX_H_OFFSET)
+#define SCLERA_CACHE_H (TFT_VER_RES + 2 * EYE_MAX_V_OFFSET)
 
 // Animation state
 static int16_t anim_start_h, anim_end_h, anim_start_v, anim_end_v;
 
+// Invalidates the neighborhood of a gradient focal position: the focal
+// circle plus EYE_DIRTY_REGION_PAD, beyond which the PAD-extended radial
+// gradient changes imperceptibly when the focal point moves.
+static void invalidate_focal_region(lv_obj_t * obj, int16_t x, int16_t y, int radius)
+{
+    const int reach = radius + EYE_DIRTY_REGION_PAD;
+    lv_area_t area;
+    area.x1 = x - reach;
+    area.y1 = y - reach;
+    area.x2 = x + reach;
+    area.y2 = y + reach;
+    lv_obj_invalidate_area(obj, &area);
+}
+
 static void anim_eye_callback(void * obj, int32_t v)
 {
     // `v` is the eased progress value from the animation path, in range [0, 256].
@@ -135,21 +197,46 @@ static void anim_eye_callback(void * obj, int32_t v)
     int16_t new_h = anim_start_h + (int32_t)(anim_end_h - anim_start_h) * v / 256;
     int16_t new_v = anim_start_v + (int32_t)(anim_end_v - anim_start_v) * v / 256;
 
-    // Pupil update
-    lv_obj_t * pupil = lv_obj_get_child((lv_obj_t *) obj, NULL);
+    // Pupil update (lv_obj_set_pos invalidates the old and new pupil areas
+    // itself, so only the gradient needs manual dirty tracking)
     int16_t pupil_x = EYE_CENTER_X - PUPIL_RADIUS + new_h;
     int16_t pupil_y = EYE_CENTER_Y - PUPIL_RADIUS + new_v;
     lv_obj_set_pos(pupil, pupil_x, pupil_y);
 
-    // Sclera update
+    // Sclera update: with the gradient tile cache the focal translation is
+    // just a re-blit of the prerendered image at the new offset
+    if (sclera_image != NULL) {
+        lv_obj_set_pos(sclera_image,
+                       -EYE_MAX_H_OFFSET + new_h,
+                       -EYE_MAX_V_OFFSET + new_v);
+        return;
+    }
+
+    // No cache: move the live gradient's focal point
     const int inner_radius = 30;
+    static int16_t prev_sclera_x = EYE_CENTER_X;
+    static int16_t prev_sclera_y = EYE_CENTER_Y;
     int16_t sclera_x = EYE_CENTER_X + new_h;
     int16_t sclera_y = EYE_CENTER_Y + new_v;
     SCLERA_GRADIENT.params.radial.focal.x = sclera_x;
     SCLERA_GRADIENT.params.radial.focal.y = sclera_y;
     SCLERA_GRADIENT.params.radial.focal_extent.x = sclera_x + inner_radius;
     SCLERA_GRADIENT.params.radial.focal_extent.y = sclera_y + inner_radius;
-    lv_obj_invalidate((lv_obj_t *)obj);
+
+    // Redraw only the union of the old and new focal neighborhoods; a large
+    // jump (e.g. the first tick after a BLE-commanded saccade) falls back to
+    // invalidating the whole object
+    int16_t dx = sclera_x - prev_sclera_x;
+    int16_t dy = sclera_y - prev_sclera_y;
+    if (abs(dx) > EYE_DIRTY_FULL_REDRAW_THRESHOLD ||
+        abs(dy) > EYE_DIRTY_FULL_REDRAW_THRESHOLD) {
+        lv_obj_invalidate((lv_obj_t *)obj);
+    } else {
+        invalidate_focal_region((lv_obj_t *)obj, prev_sclera_x, prev_sclera_y, inner_radius);
+        invalidate_focal_region((lv_obj_t *)obj, sclera_x, sclera_y, inner_radius);
+    }
+    prev_sclera_x = sclera_x;
+    prev_sclera_y = sclera_y;
 }
 
 void animate_eye_to(int16_t target_h, int16_t target_v, uint32_t duration) {
@@ -177,6 +264,62 @@ void animate_eye_to(int16_t target_h, int16_t target_v, uint32_t duration) {
     current_eye_v = target_v;
 }
 
+// Renders the sclera gradient once into a PSRAM tile, with the focal point
+// at the tile center. Must be called after SCLERA_GRADIENT is initialized.
+// Returns false (leaving the live-gradient path in place) when no PSRAM is
+// available or the allocation fails.
+static bool sclera_cache_init(void)
+{
+    if (!psramFound()) {
+        return false;
+    }
+
+    size_t buf_size = (size_t)SCLERA_CACHE_W * SCLERA_CACHE_H * (LV_COLOR_DEPTH / 8);
+    sclera_cache_buf = (uint8_t *)heap_caps_malloc(buf_size, MALLOC_CAP_SPIRAM);
+    if (sclera_cache_buf == NULL) {
+        return false;
+    }
+
+    // Render the gradient into the tile through a temporary canvas. The
+    // gradient geometry is SCLERA_GRADIENT translated so the focal point
+    // sits at the tile center.
+    lv_obj_t * canvas = lv_canvas_create(lv_screen_active());
+    lv_canvas_set_buffer(canvas, sclera_cache_buf, SCLERA_CACHE_W, SCLERA_CACHE_H,
+                         LV_COLOR_FORMAT_RGB565);
+
+    lv_layer_t layer;
+    lv_canvas_init_layer(canvas, &layer);
+
+    lv_draw_rect_dsc_t dsc;
+    lv_draw_rect_dsc_init(&dsc);
+    lv_grad_dsc_t grad = SCLERA_GRADIENT;
+    grad.params.radial.end.x += EYE_MAX_H_OFFSET;
+    grad.params.radial.end.y += EYE_MAX_V_OFFSET;
+    grad.params.radial.end_extent.x += EYE_MAX_H_OFFSET;
+    grad.params.radial.end_extent.y += EYE_MAX_V_OFFSET;
+    grad.params.radial.focal.x += EYE_MAX_H_OFFSET;
+    grad.params.radial.focal.y += EYE_MAX_V_OFFSET;
+    grad.params.radial.focal_extent.x += EYE_MAX_H_OFFSET;
+    grad.params.radial.focal_extent.y += EYE_MAX_V_OFFSET;
+    dsc.bg_grad = grad;
+
+    lv_area_t coords = {0, 0, SCLERA_CACHE_W - 1, SCLERA_CACHE_H - 1};
+    lv_draw_rect(&layer, &dsc, &coords);
+    lv_canvas_finish_layer(canvas, &layer);
+    lv_obj_delete(canvas);
+
+    // Wrap the rendered tile in an image descriptor for blitting
+    lv_memset(&sclera_cache_dsc, 0, sizeof(sclera_cache_dsc));
+    sclera_cache_dsc.header.magic = LV_IMAGE_HEADER_MAGIC;
+    sclera_cache_dsc.header.cf = LV_COLOR_FORMAT_RGB565;
+    sclera_cache_dsc.header.w = SCLERA_CACHE_W;
+    sclera_cache_dsc.header.h = SCLERA_CACHE_H;
+    sclera_cache_dsc.data = sclera_cache_buf;
+    sclera_cache_dsc.data_size = buf_size;
+
+    return true;
+}
+
 void draw_outer_eyeball(int center_x, int center_y, int offset_x, int offset_y)
 {
     // Gradient Docs: https://docs.lvgl.io/9.3/details/main-modules/draw/draw_descriptors.html#radial-gradients and
@@ -211,16 +354,29 @@ void draw_outer_eyeball(int center_x, int center_y, int offset_x, int offset_y)
      *main circle.*/
     lv_grad_radial_set_focal(&SCLERA_GRADIENT, center_x + offset_x, center_y + offset_y, inner_radius);
 
-    /*Set the widget containing the gradient*/
-    lv_style_set_bg_grad(&style, &SCLERA_GRADIENT);
-    lv_style_set_border_width(&style, 0);
-
-    /*Create an object with the new style*/
+    /*Create the eye container*/
     eye = lv_obj_create(lv_screen_active());
-    lv_obj_add_style(eye, &style, 0);
     lv_obj_set_size(eye, lv_pct(100), lv_pct(100));
     lv_obj_center(eye);
 
+    if (sclera_cache_init()) {
+        /*Blit path: transparent container holding the prerendered tile*/
+        lv_style_set_bg_opa(&style, LV_OPA_TRANSP);
+        lv_style_set_border_width(&style, 0);
+        lv_obj_add_style(eye, &style, 0);
+
+        sclera_image = lv_image_create(eye);
+        lv_image_set_src(sclera_image, &sclera_cache_dsc);
+        lv_obj_set_pos(sclera_image,
+                       -EYE_MAX_H_OFFSET + offset_x,
+                       -EYE_MAX_V_OFFSET + offset_y);
+    } else {
+        /*Fallback: evaluate the gradient live (no PSRAM)*/
+        lv_style_set_bg_grad(&style, &SCLERA_GRADIENT);
+        lv_style_set_border_width(&style, 0);
+        lv_obj_add_style(eye, &style, 0);
+    }
+
     // pupil
     pupil = lv_obj_create(eye);
     lv_obj_set_size(pupil, PUPIL_RADIUS, PUPIL_RADIUS);
@@ -305,6 +461,11 @@ const char CMD_EYE[] PROGMEM = "eye ";
 const char CMD_BLINK[] PROGMEM = "blink";
 const char CMD_HOME[] PROGMEM = "home";
 const char CMD_HELP[] PROGMEM = "help";
+const char CMD_STATS[] PROGMEM = "stats";
+const char CMD_SYNC[] PROGMEM = "sync ";
+const char CMD_START_AT[] PROGMEM = "start ";
+const char CMD_CAL[] PROGMEM = "cal ";
+const char CMD_OTA[] PROGMEM = "ota";
 
 // Helper for case-insensitive PROGMEM string comparison
 int strcasecmp_P(const char *a, const char *b_P) {
@@ -334,19 +495,76 @@ class MyServerCallbacks: public BLEServerCallbacks {
       deviceConnected = true;
     };
 
+    // The parameterized overload carries the central's address, which the
+    // governor needs for connection parameter update requests
+    void onConnect(BLEServer* pServer, esp_ble_gatts_cb_param_t* param) {
+      connParams.onConnect(pServer, param->connect.remote_bda);
+    }
+
     void onDisconnect(BLEServer* pServer) {
       deviceConnected = false;
+      connParams.onDisconnect();
     }
 };
 
 class CommandCharacteristicCallbacks: public BLECharacteristicCallbacks {
     void onWrite(BLECharacteristic *pCharacteristic) {
-      String value = pCharacteristic->getValue();
+      // Read the characteristic's raw data pointer directly -- no Arduino
+      // String construction, so a multi-hour command stream allocates
+      // nothing. Only the bytes are copied here; parsing and execution
+      // (UART writes, eye animations) happen in the motion task. Doing
+      // real work in this callback stalls the BLE stack and drops
+      // notifications under load.
+      size_t len = pCharacteristic->getLength();
+      if (len > 0) {
+        commandRing.push((const char*)pCharacteristic->getData(), len);
+      }
+    }
+};
+
+class UploadCharacteristicCallbacks: public BLECharacteristicCallbacks {
+    void onWrite(BLECharacteristic *pCharacteristic) {
+      // Chunks memcpy into PSRAM staging; CRC verification and the flash
+      // write happen in the motion task at commit, never here
+      size_t len = pCharacteristic->getLength();
+      if (len > 0) {
+        sequenceUpload.handlePacket(pCharacteristic->getData(), len);
+      }
+    }
+};
+
+class OtaCharacteristicCallbacks: public BLECharacteristicCallbacks {
+    void onWrite(BLECharacteristic *pCharacteristic) {
+      // Same discipline as the sequence upload: chunks memcpy into PSRAM;
+      // CRC verification and flash writes happen on the OTA task
+      size_t len = pCharacteristic->getLength();
+      if (len > 0) {
+        otaUpdate.handlePacket(pCharacteristic->getData(), len);
+      }
+    }
+};
+
+class EnvelopeCharacteristicCallbacks: public BLECharacteristicCallbacks {
+    void onWrite(BLECharacteristic *pCharacteristic) {
+      // Write-without-response envelope stream: decode straight into the
+      // sample ring (a few adds and byte stores), nothing heavier
+      size_t len = pCharacteristic->getLength();
+      if (len > 0) {
+        talkEnvelope.pushPacket(pCharacteristic->getData(), len);
+      }
+    }
+};
 
-      if (value.length() > 0) {
-        // Copy the received value to the command buffer
-        strncpy(commandBuffer, value.c_str(), MAX_COMMAND_LENGTH - 1);
-        commandBuffer[MAX_COMMAND_LENGTH - 1] = '\0'; // Ensure null termination
+// Drains the command ring: strips whitespace and executes each pending
+// command. Called from the motion task every tick.
+void drainCommandRing() {
+    uint8_t rawLen;
+    while (commandRing.pop(commandBuffer, &rawLen)) {
+        // Binary opcode commands start with a byte below 0x20
+        if (rawLen > 0 && (uint8_t)commandBuffer[0] < 0x20) {
+            processBinaryCommand((const uint8_t*)commandBuffer, rawLen);
+            continue;
+        }
 
         // Strip trailing whitespace (like the newline from the python script)
         int len = strlen(commandBuffer);
@@ -355,323 +573,417 @@ class CommandCharacteristicCallbacks: public BLECharacteristicCallbacks {
         }
 
         // Process the command if it's not empty after stripping
-        if (strlen(commandBuffer) > 0) {
+        if (len > 0) {
             processBluetoothCommand(commandBuffer);
         }
-      }
     }
-};
+}
 
-void processBluetoothCommand(const char* command) {
-    if (strcasecmp_P(command, CMD_START) == 0) {
-        sequencePaused = false;
-        sequenceStartTime = 0;
-        nextKeyframeIndex = 0;
-        pResponseCharacteristic->setValue("OK");
-        pResponseCharacteristic->notify();
+// Sends a response string and notifies the client. All responses are
+// string literals or static buffers, and the explicit-length setValue
+// overload avoids building a temporary String, so the response path
+// allocates nothing per command.
+static void respond(const char* msg) {
+    pResponseCharacteristic->setValue((uint8_t*)msg, strlen(msg));
+    pResponseCharacteristic->notify();
+}
 
-    } else if (strcasecmp_P(command, CMD_STOP) == 0) {
-        sequencePaused = true;
-        sequenceStartTime = 0;
-        nextKeyframeIndex = 0;
-        pResponseCharacteristic->setValue("OK");
-        pResponseCharacteristic->notify();
+// -----------------------------------------------------------------------------
+// Text command handlers. Each receives the text following its command name
+// (empty string for exact-match commands).
+// -----------------------------------------------------------------------------
 
-    } else if (strcasecmp_P(command, CMD_PAUSE) == 0) {
-        sequencePaused = true;
-        pResponseCharacteristic->setValue("OK");
-        pResponseCharacteristic->notify();
+static void cmdStart(const char*) {
+    sequencePaused = false;
+    sequenceStartTime = 0;
+    sequencePausedOffset = 0;
+    respond("OK");
+}
 
-    } else if (strcasecmp_P(command, CMD_RESUME) == 0) {
+// `start <showTimeMs>`: arm the sequence to begin at a shared show-time
+// instant. The controller sends the same downbeat to every skull, so all
+// of them leave keyframe zero on the same synced millisecond.
+static void cmdStartAt(const char* args) {
+    unsigned long showStart;
+    if (sscanf(args, "%lu", &showStart) == 1 && showStart != 0) {
+        sequenceEngine.seekTo(0);
+        interpValid = false;
+        sequencePausedOffset = 0;
+        sequenceStartTime = showStart;
         sequencePaused = false;
-        pResponseCharacteristic->setValue("OK");
-        pResponseCharacteristic->notify();
+        respond("OK");
+    } else {
+        respond("ERR");
+    }
+}
+
+// `sync <masterMs>`: timebase beacon from the controller. Replies with the
+// disciplined offset so the controller can watch convergence.
+static void cmdSync(const char* args) {
+    unsigned long masterMs;
+    if (sscanf(args, "%lu", &masterMs) == 1) {
+        syncedClock.discipline(millis(), (uint32_t)masterMs);
+        char buf[24];
+        snprintf(buf, sizeof(buf), "OK %ld", syncedClock.offsetMs());
+        respond(buf);
+    } else {
+        respond("ERR");
+    }
+}
+
+static void cmdStop(const char*) {
+    sequencePaused = true;
+    sequenceStartTime = 0;
+    sequencePausedOffset = 0;
+    respond("OK");
+}
 
-    } else if (strcasecmp_P(command, CMD_MODE_SCRIPTED) == 0) {
-        currentMode = OperationMode::SCRIPTED;
+static void cmdPause(const char*) {
+    // Capture the current offset so resume can re-seek to it
+    if (!sequencePaused && sequenceStartTime != 0) {
+        sequencePausedOffset = syncedClock.now(millis()) - sequenceStartTime;
         sequenceStartTime = 0;
-        nextKeyframeIndex = 0;
-        talkingStartTime = 0; // Stop talking when switching modes
-        pResponseCharacteristic->setValue("OK");
-        pResponseCharacteristic->notify();
-
-    } else if (strcasecmp_P(command, CMD_MODE_DYNAMIC) == 0) {
-        currentMode = OperationMode::DYNAMIC;
-        lastDynamicMovement = 0; // Reset dynamic mode timing
-        dynamicModeInitialized = true;
-        // Note: Does not stop talking, allows mode switch while talking
-        pResponseCharacteristic->setValue("OK");
-        pResponseCharacteristic->notify();
-
-    } else if (strcasecmp_P(command, CMD_TALK_START) == 0) {
-        // Talking is a state, not a mode. Ensure we are in dynamic mode for head movement.
-        currentMode = OperationMode::DYNAMIC;
-        talkingStartTime = millis();
-        talkSegmentStartTime = millis();
-        currentTalkSegmentDuration = 0; // Force immediate randomization of jaw params
-        pResponseCharacteristic->setValue("OK");
-        pResponseCharacteristic->notify();
-
-    } else if (strcasecmp_P(command, CMD_TALK_STOP) == 0) {
-        talkingStartTime = 0;
-        // Set jaw to closed position when talking stops
-        maestro.setTarget(SKULL_JAW_CHANNEL, JAW_CLOSED);
-        pResponseCharacteristic->setValue("OK");
-        pResponseCharacteristic->notify();
-
-    } else if (strcasecmp_P(command, CMD_STATUS) == 0) {
-        if (currentMode == OperationMode::SCRIPTED) {
-            pResponseCharacteristic->setValue("S");
-        } else if (currentMode == OperationMode::DYNAMIC) {
-            if (talkingStartTime != 0) {
-                pResponseCharacteristic->setValue("D+T");
-            } else {
-                pResponseCharacteristic->setValue("D");
-            }
-        }
-        pResponseCharacteristic->notify();
-
-    } else if (strncasecmp_P(command, CMD_SERVO, strlen_P(CMD_SERVO)) == 0) {
-        int channel, position;
-        if (sscanf(command + strlen_P(CMD_SERVO), "%d %d", &channel, &position) == 2) {
-            if (validateServoPosition(channel, position)) {
-                maestro.setTarget(channel, position);
-                pResponseCharacteristic->setValue("OK");
-            } else {
-                pResponseCharacteristic->setValue("ERR");
-            }
-        } else {
-            pResponseCharacteristic->setValue("ERR");
-        }
-        pResponseCharacteristic->notify();
-
-    } else if (strncasecmp_P(command, CMD_EYE, strlen_P(CMD_EYE)) == 0) {
-        int h_offset, v_offset;
-        if (sscanf(command + strlen_P(CMD_EYE), "%d %d", &h_offset, &v_offset) == 2) {
-            if (validateEyePosition(h_offset, v_offset)) {
-                animate_eye_to(h_offset, v_offset, DEFAULT_EYE_ANIMATION_DURATION);
-                pResponseCharacteristic->setValue("OK");
-            } else {
-                pResponseCharacteristic->setValue("ERR");
-            }
-        } else {
-            pResponseCharacteristic->setValue("ERR");
-        }
-        pResponseCharacteristic->notify();
+    }
+    sequencePaused = true;
+    respond("OK");
+}
 
-    } else if (strcasecmp_P(command, CMD_BLINK) == 0) {
-        trigger_blink();
-        pResponseCharacteristic->setValue("OK");
-        pResponseCharacteristic->notify();
+static void cmdResume(const char*) {
+    sequencePaused = false;
+    respond("OK");
+}
 
-    } else if (strcasecmp_P(command, CMD_HOME) == 0) {
-        // Move all servos to home positions
-        bool allValid = true;
-        for (int i = 0; i < NUM_SERVOS; i++) {
-            const ServoRange* range = &SERVO_RANGES[i];
-            if (validateServoPosition(range->channel, range->home)) {
-                maestro.setTarget(range->channel, range->home);
-            } else {
-                allValid = false;
-            }
-        }
+static void cmdModeScripted(const char*) {
+    currentMode = OperationMode::SCRIPTED;
+    sequenceStartTime = 0;
+    sequencePausedOffset = 0;
+    talkingStartTime = 0; // Stop talking when switching modes
+    respond("OK");
+}
 
-        // Move eyes to center
-        if (validateEyePosition(EYE_H_CENTER, EYE_V_CENTER)) {
-            animate_eye_to(EYE_H_CENTER, EYE_V_CENTER, DEFAULT_EYE_ANIMATION_DURATION);
-        } else {
-            allValid = false;
-        }
+static void cmdModeDynamic(const char*) {
+    currentMode = OperationMode::DYNAMIC;
+    // The dynamic movement event free-runs on the motion scheduler and
+    // checks the mode when it fires, so nothing to reset here.
+    // Note: Does not stop talking, allows mode switch while talking
+    respond("OK");
+}
 
-        pResponseCharacteristic->setValue(allValid ? "OK" : "ERR");
-        pResponseCharacteristic->notify();
+static void cmdTalkStart(const char*) {
+    // Talking is a state, not a mode. Ensure we are in dynamic mode for head movement.
+    currentMode = OperationMode::DYNAMIC;
+    talkingStartTime = millis();
+    talkSegmentStartTime = millis();
+    currentTalkSegmentDuration = 0; // Force immediate randomization of jaw params
+    respond("OK");
+}
 
-    } else if (strcasecmp_P(command, CMD_HELP) == 0) {
-        pResponseCharacteristic->setValue("start|stop|pause|resume|mode scripted|mode dynamic|talk start|talk stop|servo <ch> <pos>|eye <h> <v>|blink|home|status");
-        pResponseCharacteristic->notify();
+static void cmdTalkStop(const char*) {
+    talkingStartTime = 0;
+    talkEnvelope.reset(); // Discard any buffered envelope samples
+    // Close the jaw as the talking source's final claim; it expires after
+    // the stream TTL and lower-priority sources take the jaw back
+    servoArbiter.setTarget(ARB_SRC_TALKING, SKULL_JAW_CHANNEL, JAW_CLOSED);
+    respond("OK");
+}
 
+static void cmdStatus(const char*) {
+    if (currentMode == OperationMode::SCRIPTED) {
+        respond("S");
+    } else if (talkingStartTime != 0) {
+        respond("D+T");
     } else {
-        pResponseCharacteristic->setValue("ERR");
-        pResponseCharacteristic->notify();
+        respond("D");
     }
 }
 
-void handleBluetoothInput() {
-    // This function is now handled by the BLE characteristic callback
+static void cmdServo(const char* args) {
+    int channel, position;
+    if (sscanf(args, "%d %d", &channel, &position) == 2 &&
+        validateServoPosition(channel, position)) {
+        servoArbiter.setTarget(ARB_SRC_DIRECT, channel, position);
+        respond("OK");
+    } else {
+        respond("ERR");
+    }
 }
 
+static void cmdEye(const char* args) {
+    int h_offset, v_offset;
+    if (sscanf(args, "%d %d", &h_offset, &v_offset) == 2 &&
+        validateEyePosition(h_offset, v_offset)) {
+        requestEyeMove(h_offset, v_offset, DEFAULT_EYE_ANIMATION_DURATION);
+        respond("OK");
+    } else {
+        respond("ERR");
+    }
+}
 
+static void cmdBlink(const char*) {
+    requestBlink();
+    respond("OK");
+}
 
-void handleScriptedMode(unsigned long currentTime) {
-    // Skip processing if sequence is paused
-    if (sequencePaused) {
-        return;
+static void cmdHome(const char*) {
+    // Move all servos to home positions
+    bool allValid = true;
+    for (int i = 0; i < NUM_SERVOS; i++) {
+        const ServoRange* range = getServoRange(i);
+        if (validateServoPosition(range->channel, range->home)) {
+            servoArbiter.setTarget(ARB_SRC_DIRECT, range->channel, range->home);
+        } else {
+            allValid = false;
+        }
     }
 
-    // restart the sequence if it's the first run
-    if (sequenceStartTime == 0) {
-      sequenceStartTime = currentTime;
-      nextKeyframeIndex = 0;
+    // Move eyes to center
+    if (validateEyePosition(EYE_H_CENTER, EYE_V_CENTER)) {
+        requestEyeMove(EYE_H_CENTER, EYE_V_CENTER, DEFAULT_EYE_ANIMATION_DURATION);
+    } else {
+        allValid = false;
     }
 
-    unsigned long sequenceTime = currentTime - sequenceStartTime;
-
-    // Check if it's time to trigger the next keyframe
-    uint32_t currentStartTime = pgm_read_dword(&sequence[nextKeyframeIndex].startTime);
-    if (nextKeyframeIndex < NUM_KEYFRAMES && sequenceTime >= currentStartTime) {
-        Keyframe currentKeyframe;
-        memcpy_P(&currentKeyframe, &sequence[nextKeyframeIndex], sizeof(Keyframe));
+    respond(allValid ? "OK" : "ERR");
+}
 
-        // Send the target positions for the current keyframe
+// `cal` subcommands edit the per-unit servo calibration (NVS-backed, see
+// config.cpp): one firmware image for the fleet, mechanical adjustments
+// without a reflash.
+//   cal show                          -> "ch:min,max,home,speed,accel|..."
+//   cal range <ch> <min> <max> <home>
+//   cal motion <ch> <speed> <accel>   (also applied to the Maestro live)
+//   cal reset                         (back to compiled defaults)
+static void cmdCal(const char* args) {
+    if (strncasecmp(args, "show", 4) == 0) {
+        static char report[128];
+        int n = 0;
         for (int i = 0; i < NUM_SERVOS; i++) {
-            uint8_t channel = pgm_read_byte(&SERVO_RANGES[i].channel);
-            uint16_t position = currentKeyframe.positions[i];
-
-            // Validate position before sending to servo
-            if (validateServoPosition(channel, position)) {
-                maestro.setTarget(channel, position);
-            }
+            const ServoRange* r = getServoRange(i);
+            const ServoMotionConfig* m = getServoMotionConfig(i);
+            n += snprintf(report + n, sizeof(report) - n, "%s%d:%u,%u,%u,%u,%u",
+                          (i > 0) ? "|" : "", i, r->min, r->max, r->home,
+                          m->speed, m->acceleration);
         }
+        respond(report);
+        return;
+    }
 
-        // Animate the eye to the new position
-        uint32_t duration = DEFAULT_EYE_ANIMATION_DURATION;
-        if (nextKeyframeIndex + 1 < NUM_KEYFRAMES) {
-            uint32_t nextStartTime = pgm_read_dword(&sequence[nextKeyframeIndex + 1].startTime);
-            duration = nextStartTime - currentKeyframe.startTime;
-        }
-        // Validate eye position before animating
-        if (validateEyePosition(currentKeyframe.eye_h_pos, currentKeyframe.eye_v_pos) &&
-            validateTiming(duration)) {
-            animate_eye_to(currentKeyframe.eye_h_pos, currentKeyframe.eye_v_pos, duration);
+    if (strncasecmp(args, "range ", 6) == 0) {
+        int ch, minPos, maxPos, home;
+        if (sscanf(args + 6, "%d %d %d %d", &ch, &minPos, &maxPos, &home) == 4 &&
+            setServoRangeCalibration(ch, minPos, maxPos, home)) {
+            respond("OK");
+        } else {
+            respond("ERR");
         }
+        return;
+    }
 
-        nextKeyframeIndex++;
+    if (strncasecmp(args, "motion ", 7) == 0) {
+        int ch, speed, accel;
+        if (sscanf(args + 7, "%d %d %d", &ch, &speed, &accel) == 3 &&
+            setServoMotionCalibration(ch, speed, accel)) {
+            // Push the new limits to the Maestro immediately; four-byte
+            // frames, same as the setup()-time configuration
+            maestro.setSpeed(ch, speed);
+            maestro.setAcceleration(ch, accel);
+            respond("OK");
+        } else {
+            respond("ERR");
+        }
+        return;
     }
 
-    // Reset the sequence when it's over
-    if (nextKeyframeIndex >= NUM_KEYFRAMES) {
-        // Optional: add a delay here before looping
-        sequenceStartTime = 0; // this will restart the sequence on the next loop
+    if (strncasecmp(args, "reset", 5) == 0) {
+        clearServoCalibration();
+        respond("OK");
+        return;
     }
+
+    respond("ERR");
 }
 
-// Helper functions for dynamic mode
-inline uint16_t max(uint16_t a, uint16_t b) { return (a > b) ? a : b; }
-inline uint16_t min(uint16_t a, uint16_t b) { return (a < b) ? a : b; }
+static void cmdStats(const char*) {
+    static char report[384];
+    size_t n = profilerFormatReport(report, sizeof(report));
+    // Budget manager counters: how often each loop overran and how often
+    // optional work was shed in response
+    snprintf(report + n, sizeof(report) - n,
+             "budget,motion,%lu,%lu\nbudget,render,%lu,%lu\n",
+             (unsigned long)motionBudget.overruns(),
+             (unsigned long)motionBudget.sheds(),
+             (unsigned long)renderBudget.overruns(),
+             (unsigned long)renderBudget.sheds());
+    respond(report);
+}
 
-void generateDynamicKeyframe(unsigned long currentTime, bool isTalking) {
-    DynamicModeConfig config;
-    // Select config based on whether the animatronic is talking
-    if (isTalking) {
-        memcpy_P(&config, &TALKING_DYNAMIC_CONFIG, sizeof(DynamicModeConfig));
-    } else {
-        memcpy_P(&config, &DEFAULT_DYNAMIC_CONFIG, sizeof(DynamicModeConfig));
-    }
+static void cmdOta(const char*) {
+    respond(otaUpdate.statusString());
+}
 
-    // Generate procedural servo positions within configured ranges
-    for (int i = 0; i < NUM_SERVOS; i++) {
-        ServoRange range_progmem;
-        memcpy_P(&range_progmem, &SERVO_RANGES[i], sizeof(ServoRange));
+static void cmdHelp(const char*) {
+    respond("start|start <atMs>|stop|pause|resume|sync <masterMs>|mode scripted|mode dynamic|talk start|talk stop|servo <ch> <pos>|eye <h> <v>|blink|home|status|stats|cal show|cal range|cal motion|cal reset|ota");
+}
 
-        // If talking, skip the jaw servo to let handleJawMovement control it
-        if (isTalking && range_progmem.channel == SKULL_JAW_CHANNEL) {
-            continue;
-        }
+// -----------------------------------------------------------------------------
+// Command dispatch table. Matching pre-keys on the first character and the
+// length before doing a full comparison, so a miss costs two byte compares
+// instead of a per-byte PROGMEM string walk. The hottest streamed commands
+// (servo, eye) sit first.
+// -----------------------------------------------------------------------------
+
+typedef void (*CommandHandler)(const char* args);
+
+struct CommandEntry {
+    const char* name;       // PROGMEM command string
+    uint8_t nameLen;        // Length of the name (including prefix space)
+    char firstChar;         // Lowercase first character, for the fast reject
+    bool isPrefix;          // true if the command takes trailing arguments
+    CommandHandler handler;
+};
+
+static const CommandEntry COMMAND_TABLE[] = {
+    { CMD_SERVO,         sizeof("servo ") - 1,        's', true,  cmdServo        },
+    { CMD_EYE,           sizeof("eye ") - 1,          'e', true,  cmdEye          },
+    { CMD_START,         sizeof("start") - 1,         's', false, cmdStart        },
+    { CMD_START_AT,      sizeof("start ") - 1,        's', true,  cmdStartAt      },
+    { CMD_SYNC,          sizeof("sync ") - 1,         's', true,  cmdSync         },
+    { CMD_STOP,          sizeof("stop") - 1,          's', false, cmdStop         },
+    { CMD_PAUSE,         sizeof("pause") - 1,         'p', false, cmdPause        },
+    { CMD_RESUME,        sizeof("resume") - 1,        'r', false, cmdResume       },
+    { CMD_MODE_SCRIPTED, sizeof("mode scripted") - 1, 'm', false, cmdModeScripted },
+    { CMD_MODE_DYNAMIC,  sizeof("mode dynamic") - 1,  'm', false, cmdModeDynamic  },
+    { CMD_TALK_START,    sizeof("talk start") - 1,    't', false, cmdTalkStart    },
+    { CMD_TALK_STOP,     sizeof("talk stop") - 1,     't', false, cmdTalkStop     },
+    { CMD_STATUS,        sizeof("status") - 1,        's', false, cmdStatus       },
+    { CMD_BLINK,         sizeof("blink") - 1,         'b', false, cmdBlink        },
+    { CMD_HOME,          sizeof("home") - 1,          'h', false, cmdHome         },
+    { CMD_STATS,         sizeof("stats") - 1,         's', false, cmdStats        },
+    { CMD_CAL,           sizeof("cal ") - 1,          'c', true,  cmdCal          },
+    { CMD_OTA,           sizeof("ota") - 1,           'o', false, cmdOta          },
+    { CMD_HELP,          sizeof("help") - 1,          'h', false, cmdHelp         },
+};
+const int NUM_COMMANDS = sizeof(COMMAND_TABLE) / sizeof(CommandEntry);
+
+void processBluetoothCommand(const char* command) {
+    ScopedProfile prof(PROF_BLE_COMMAND);
 
-        // Calculate movement range based on intensity
-        uint16_t centerPos = range_progmem.home;
-        uint16_t rangeSize = (range_progmem.max - range_progmem.min) * config.movementIntensity;
-        uint16_t minPos = centerPos - (rangeSize / 2);
-        uint16_t maxPos = centerPos + (rangeSize / 2);
+    size_t len = strlen(command);
+    char first = tolower(command[0]);
 
-        // Ensure we stay within absolute servo limits
-        minPos = max(minPos, range_progmem.min);
-        maxPos = min(maxPos, range_progmem.max);
+    for (int i = 0; i < NUM_COMMANDS; i++) {
+        const CommandEntry* entry = &COMMAND_TABLE[i];
 
-        // Generate random position within calculated range
-        uint16_t targetPosition = random(minPos, maxPos + 1);
+        // Fast rejects: first character, then length
+        if (first != entry->firstChar) {
+            continue;
+        }
+        if (entry->isPrefix ? (len < entry->nameLen) : (len != entry->nameLen)) {
+            continue;
+        }
 
-        // Validate and send position
-        if (validateServoPosition(range_progmem.channel, targetPosition)) {
-            maestro.setTarget(range_progmem.channel, targetPosition);
+        if (strncasecmp_P(command, entry->name, entry->nameLen) == 0) {
+            entry->handler(command + entry->nameLen);
+            return;
         }
     }
 
-    // Generate procedural eye movement
-    int16_t maxEyeH = EYE_H_RIGHT * config.movementIntensity;
-    int16_t maxEyeV = EYE_V_DOWN * config.movementIntensity;
+    respond("ERR");
+}
 
-    int16_t targetEyeH = random(-maxEyeH, maxEyeH + 1);
-    int16_t targetEyeV = random(-maxEyeV, maxEyeV + 1);
+// -----------------------------------------------------------------------------
+// Compact binary protocol for high-rate streaming. A first byte below 0x20
+// can never start a text command, so both protocols share the command
+// characteristic. Successful binary commands are intentionally silent (no
+// notify) to keep BLE airtime down at 20-50 commands/sec; failures still
+// respond with ERR.
+// -----------------------------------------------------------------------------
+
+const uint8_t OP_SERVO = 0x01; // channel(u8), target(u16 little-endian)
+const uint8_t OP_EYE   = 0x02; // h(int8), v(int8)
+
+void processBinaryCommand(const uint8_t* data, uint8_t len) {
+    switch (data[0]) {
+        case OP_SERVO:
+            if (len >= 4) {
+                uint8_t channel = data[1];
+                uint16_t position = data[2] | ((uint16_t)data[3] << 8);
+                if (validateServoPosition(channel, position)) {
+                    servoArbiter.setTarget(ARB_SRC_DIRECT, channel, position);
+                    return;
+                }
+            }
+            respond("ERR");
+            break;
 
-    // Generate random animation duration
-    uint32_t duration = random(config.minHoldDuration, config.maxHoldDuration);
+        case OP_EYE:
+            if (len >= 3) {
+                int16_t h_offset = (int8_t)data[1];
+                int16_t v_offset = (int8_t)data[2];
+                if (validateEyePosition(h_offset, v_offset)) {
+                    requestEyeMove(h_offset, v_offset, DEFAULT_EYE_ANIMATION_DURATION);
+                    return;
+                }
+            }
+            respond("ERR");
+            break;
 
-    // Validate and animate eyes
-    if (validateEyePosition(targetEyeH, targetEyeV) && validateTiming(duration)) {
-        animate_eye_to(targetEyeH, targetEyeV, duration);
+        default:
+            respond("ERR");
+            break;
     }
 }
 
-void handleDynamicMode(unsigned long currentTime) {
-    // Skip processing if sequence is paused
-    if (sequencePaused) {
-        return;
-    }
+void handleBluetoothInput() {
+    // This function is now handled by the BLE characteristic callback
+}
 
-    // Initialize dynamic mode timing on first run
-    if (!dynamicModeInitialized || lastDynamicMovement == 0) {
-        lastDynamicMovement = currentTime;
-        nextDynamicMovement = currentTime + random(dynamicConfig.minMovementInterval, dynamicConfig.maxMovementInterval);
-        dynamicModeInitialized = true;
+// Builds the current telemetry snapshot and notifies it if the gate deems
+// it newsworthy. Runs at the end of every motion tick; the gate's rate
+// limit keeps airtime bounded no matter the tick rate.
+void publishTelemetry(unsigned long now) {
+    if (!deviceConnected) {
         return;
     }
 
-    // Check if it's time for the next dynamic movement
-    if (currentTime >= nextDynamicMovement) {
-        // Pass the talking state to the keyframe generator
-        generateDynamicKeyframe(currentTime, talkingStartTime != 0);
-
-        // Schedule next movement
-        lastDynamicMovement = currentTime;
-        nextDynamicMovement = currentTime + random(dynamicConfig.minMovementInterval, dynamicConfig.maxMovementInterval);
+    TelemetryPacket packet;
+    packet.version = TELEMETRY_VERSION;
+    packet.mode = (uint8_t)currentMode;
+    packet.flags = 0;
+    if (talkingStartTime != 0 || talkEnvelope.active()) {
+        packet.flags |= TELEMETRY_FLAG_TALKING;
     }
-}
-
-void handleJawMovement(unsigned long currentTime) {
-    if (talkingStartTime == 0) {
-        return; // Not talking
+    if (sequencePaused) {
+        packet.flags |= TELEMETRY_FLAG_PAUSED;
     }
-
-    // Periodically randomize the talking speed and amplitude for a more natural effect
-    if (currentTime - talkSegmentStartTime > currentTalkSegmentDuration) {
-        talkSegmentStartTime = currentTime;
-        currentJawSpeed = random(10, 25) / 10.0f; // Random speed between 1.0 and 2.5 Hz
-        currentJawAmplitude = random(50, 101) / 100.0f; // Random amplitude between 50% and 100%
-        currentTalkSegmentDuration = random(200, 1000);
+    if (motionTaskIdle) {
+        packet.flags |= TELEMETRY_FLAG_IDLE;
     }
+    if (syncedClock.synced(now)) {
+        packet.flags |= TELEMETRY_FLAG_SYNCED;
+    }
+    packet.reserved = 0;
+    packet.keyframeIndex = (uint16_t)sequenceEngine.index();
+    packet.keyframeCount = (uint16_t)sequenceEngine.count();
+    for (int i = 0; i < NUM_SERVOS; i++) {
+        uint16_t target = 0;
+        servoTxQueue.lastSentTarget(i, &target);
+        packet.servoTargets[i] = target;
+    }
+    packet.motionTickUs = lastMotionTickUs;
+    packet.freeHeap = ESP.getFreeHeap();
+    packet.connIntervalUnits = connParams.requestedIntervalUnits();
 
-    // Calculate the jaw position using a sine wave
-    float time_sec = (currentTime - talkingStartTime) / 1000.0f;
-    float sin_wave = sin(time_sec * 2 * PI * currentJawSpeed);
-
-    // Map the sine wave (-1 to 1) to the jaw's servo range
-    uint16_t jaw_range = JAW_OPEN - JAW_CLOSED;
-    uint16_t jaw_position = JAW_CLOSED + (jaw_range / 2) + (sin_wave * (jaw_range / 2) * currentJawAmplitude);
-
-    // Ensure the position is within the valid range
-    jaw_position = max(JAW_CLOSED, min(JAW_OPEN, jaw_position));
-
-    // Send the new position to the jaw servo
-    if (validateServoPosition(SKULL_JAW_CHANNEL, jaw_position)) {
-        maestro.setTarget(SKULL_JAW_CHANNEL, jaw_position);
+    if (telemetryGate.shouldSend(packet, now)) {
+        pTelemetryCharacteristic->setValue((uint8_t*)&packet, sizeof(packet));
+        pTelemetryCharacteristic->notify();
     }
 }
 
 void update_pupil_color() {
     // Using a static variable to track the last state avoids unnecessary LVGL calls
     static bool lastIsTalking = false;
-    bool isTalking = (talkingStartTime != 0);
+    bool isTalking = (talkingStartTime != 0) || talkEnvelope.active();
 
     if (isTalking != lastIsTalking) {
         if (isTalking) {
@@ -684,16 +996,123 @@ void update_pupil_color() {
 }
 
 
-void setup()
+// =============================================================================
+// RENDER-LOOP SCHEDULED EVENTS
+// =============================================================================
+
+// Automatic blink: fires, then re-arms itself with a fresh random interval
+void blinkCallback(unsigned long now) {
+    trigger_blink();
+    // Keep LVGL ticking long enough to play the whole blink while idle
+    uiActiveUntil = now + DEFAULT_BLINK_CLOSE_DURATION
+                  + DEFAULT_BLINK_PAUSE_DURATION
+                  + DEFAULT_BLINK_OPEN_DURATION + 100;
+    uiScheduler.schedule(&blinkEvent,
+                         now + random(BLINK_INTERVAL_MIN_MS, BLINK_INTERVAL_MAX_MS),
+                         blinkCallback);
+}
+
+// Periodic profiler dump over Serial
+void profilerDumpCallback(unsigned long now) {
+    profilerDump();
+    uiScheduler.schedule(&profilerDumpEvent, now + PROFILER_DUMP_INTERVAL_MS,
+                         profilerDumpCallback);
+}
+
+// Advertising retry: restarts advertising while no client is connected
+void advertisingCallback(unsigned long now) {
+    if (!deviceConnected) {
+        BLEDevice::startAdvertising();
+        Serial.println("start advertising");
+    }
+    uiScheduler.schedule(&advertisingEvent,
+                         now + ADVERTISING_RETRY_INTERVAL_MS,
+                         advertisingCallback);
+}
+
+// =============================================================================
+// MOTION TASK
+// =============================================================================
+
+// Fixed-rate motion task pinned to MOTION_CORE. Owns all Maestro serial
+// traffic (scripted/dynamic keyframes, jaw oscillator) so that a long LVGL
+// flush on RENDER_CORE can never delay a servo update. Eye/blink work is
+// posted back to the render loop through the UI event queue.
+void motionTask(void *param)
 {
-    String LVGL_Arduino = "Hello Arduino! ";
-    LVGL_Arduino += String('V') + lv_version_major() + "." + lv_version_minor() + "." + lv_version_patch();
+    TickType_t lastWakeTime = xTaskGetTickCount();
+
+    for (;;) {
+        unsigned long currentTime = millis();
+        unsigned long tickStartUs = micros();
+
+        // Execute commands the BLE callback queued since the last tick
+        drainCommandRing();
+
+        // Install a fully-staged sequence upload: CRC verify, flash write,
+        // atomic swap. Blocks this tick for the flash write, which is fine
+        // while the show is being replaced.
+        if (sequenceUpload.commitPending()) {
+            respond(sequenceUpload.processCommit(sequenceEngine));
+            sequenceStartTime = 0; // Restart the (new) show from the top
+            sequencePausedOffset = 0;
+        }
+
+        // Fire due motion-side events (dynamic movement generator)
+        motionScheduler.runDue(currentTime);
+
+        // Scripted playback runs every tick for keyframe interpolation;
+        // after an over-budget tick it sheds the in-between interpolation
+        bool shed = motionBudget.shouldShed();
+        if (currentMode == OperationMode::SCRIPTED) {
+            handleScriptedMode(currentTime, shed);
+        }
+
+        // Handle jaw movement independently if talking
+        handleJawMovement(currentTime);
 
+        // Resolve all claims to one winning target per servo, then drain
+        // the staged targets into the UART hardware buffer
+        servoArbiter.resolve(currentTime);
+        servoTxQueue.service();
+
+        // Publish a telemetry snapshot if anything newsworthy changed
+        // (optional work: skipped on a shed tick)
+        unsigned long tickUs = micros() - tickStartUs;
+        lastMotionTickUs = (tickUs > 0xFFFF) ? 0xFFFF : (uint16_t)tickUs;
+        if (!shed) {
+            publishTelemetry(currentTime);
+        }
+        motionBudget.recordWork(tickUs);
+
+        // The idle governor stretches the tick when nothing is connected
+        // or playing; a connect snaps it back on the next wakeup
+        uint32_t period = motionTaskIdle ? IDLE_MOTION_TASK_PERIOD_MS
+                                         : MOTION_TASK_PERIOD_MS;
+        vTaskDelayUntil(&lastWakeTime, pdMS_TO_TICKS(period));
+    }
+}
+
+void setup()
+{
     Serial.begin( 9600 );
-    Serial.println( LVGL_Arduino );
+    Serial.print("Hello Arduino! V");
+    Serial.print(lv_version_major());
+    Serial.print(".");
+    Serial.print(lv_version_minor());
+    Serial.print(".");
+    Serial.println(lv_version_patch());
+
+    // Unpack the PROGMEM config tables into the RAM lookup cache before
+    // anything (including an early BLE command) validates a servo position
+    initServoConfigCache();
+    loadServoCalibration(); // Per-unit NVS overrides of the compiled defaults
 
     // Create the BLE Device
     BLEDevice::init(BT_DEVICE_NAME);
+    // Large MTU so upload chunks carry ~500 payload bytes; the central
+    // negotiates down if it can't honor it
+    BLEDevice::setMTU(BLE_MTU_REQUEST);
 
     // Create the BLE Server
     BLEServer *pServer = BLEDevice::createServer();
@@ -716,6 +1135,39 @@ void setup()
                                     );
     pResponseCharacteristic->addDescriptor(new BLE2902());
 
+    // Create a BLE Characteristic for the streamed talking envelope.
+    // Write-without-response: lip-sync packets favor throughput over
+    // delivery guarantees, and the delta encoding re-anchors per packet.
+    pEnvelopeCharacteristic = pService->createCharacteristic(
+                                        ENVELOPE_CHARACTERISTIC_UUID,
+                                        BLECharacteristic::PROPERTY_WRITE_NR
+                                    );
+    pEnvelopeCharacteristic->setCallbacks(new EnvelopeCharacteristicCallbacks());
+
+    // Create a BLE Characteristic for bulk sequence upload (chunked,
+    // write-without-response for throughput; see sequence_upload.h)
+    pUploadCharacteristic = pService->createCharacteristic(
+                                        UPLOAD_CHARACTERISTIC_UUID,
+                                        BLECharacteristic::PROPERTY_WRITE_NR
+                                    );
+    pUploadCharacteristic->setCallbacks(new UploadCharacteristicCallbacks());
+
+    // Create a BLE Characteristic for push telemetry (change-gated
+    // notifies of the packed snapshot; see telemetry.h)
+    pTelemetryCharacteristic = pService->createCharacteristic(
+                                        TELEMETRY_CHARACTERISTIC_UUID,
+                                        BLECharacteristic::PROPERTY_NOTIFY
+                                    );
+    pTelemetryCharacteristic->addDescriptor(new BLE2902());
+
+    // Create a BLE Characteristic for OTA firmware transfer (same chunk
+    // protocol as the sequence upload; see ota_update.h)
+    pOtaCharacteristic = pService->createCharacteristic(
+                                        OTA_CHARACTERISTIC_UUID,
+                                        BLECharacteristic::PROPERTY_WRITE_NR
+                                    );
+    pOtaCharacteristic->setCallbacks(new OtaCharacteristicCallbacks());
+
     // Start the service
     pService->start();
 
@@ -727,7 +1179,7 @@ void setup()
     Serial.println("Waiting a client connection to notify...");
 
 
-    maestroSerial.begin(9600, SERIAL_8N1, -1, MAESTRO_TX_PIN);
+    maestroSerial.begin(MAESTRO_BAUD_RATE, SERIAL_8N1, -1, MAESTRO_TX_PIN);
 
     // Set speed and acceleration for smooth movements
     // Speed: 0 is unlimited, 1 is 0.25 us / 10 ms, etc.
@@ -753,10 +1205,9 @@ void setup()
 
     // Configure servo motion parameters from config
     for (int i = 0; i < NUM_SERVO_MOTION_CONFIGS; i++) {
-        ServoMotionConfig config;
-        memcpy_P(&config, &SERVO_MOTION_CONFIGS[i], sizeof(ServoMotionConfig));
-        maestro.setSpeed(config.channel, config.speed);
-        maestro.setAcceleration(config.channel, config.acceleration);
+        const ServoMotionConfig* config = getServoMotionConfig(i);
+        maestro.setSpeed(config->channel, config->speed);
+        maestro.setAcceleration(config->channel, config->acceleration);
     }
 
 
@@ -765,18 +1216,8 @@ void setup()
     /*Set a tick source so that LVGL will know how much time elapsed. */
     lv_tick_set_cb(my_tick);
 
-    lv_display_t * disp;
-#if LV_USE_TFT_ESPI
-    /*TFT_eSPI can be enabled lv_conf.h to initialize the display in a simple way*/
-    disp = lv_tft_espi_create(TFT_HOR_RES, TFT_VER_RES, draw_buf, sizeof(draw_buf));
-    lv_display_set_rotation(disp, TFT_ROTATION);
-
-#else
-    /*Else create a display yourself*/
-    disp = lv_display_create(TFT_HOR_RES, TFT_VER_RES);
-    lv_display_set_flush_cb(disp, my_disp_flush);
-    lv_display_set_buffers(disp, draw_buf, NULL, sizeof(draw_buf), LV_DISPLAY_RENDER_MODE_PARTIAL);
-#endif
+    /* DMA double-buffered display; see display_flush.cpp */
+    lv_display_t * disp = displayInit();
 
     // set background color (for debug, use 0x00ff00)
     lv_obj_set_style_bg_color(lv_screen_active(), lv_color_hex(0x000000), LV_PART_MAIN);
@@ -787,55 +1228,133 @@ void setup()
     // create eyelids
     create_eyelids();
 
-    // Init blink timer
-    randomSeed(analogRead(0)); // Seed random number generator
-    last_blink_time = millis();
-    next_blink_interval = random(BLINK_INTERVAL_MIN_MS, BLINK_INTERVAL_MAX_MS);
-
-    // Initialize operation mode
-    if (currentMode == OperationMode::DYNAMIC) {
-        dynamicModeInitialized = true;
+    // Seed the random number generator, then arm the recurring events.
+    // The motion-side event is armed before the motion task exists, so no
+    // cross-task scheduling happens.
+    randomSeed(analogRead(0));
+    unsigned long now = millis();
+    uiScheduler.schedule(&blinkEvent,
+                         now + random(BLINK_INTERVAL_MIN_MS, BLINK_INTERVAL_MAX_MS),
+                         blinkCallback);
+    uiScheduler.schedule(&advertisingEvent, now, advertisingCallback);
+    uiScheduler.schedule(&profilerDumpEvent, now + PROFILER_DUMP_INTERVAL_MS,
+                         profilerDumpCallback);
+    motionScheduler.schedule(&dynamicMoveEvent,
+                             now + random(dynamicConfig.minMovementInterval,
+                                          dynamicConfig.maxMovementInterval),
+                             dynamicMoveCallback);
+
+    // Mount LittleFS and pick the sequence source (uploaded show if one
+    // exists, built-in PROGMEM sequence otherwise)
+    sequenceEngine.begin(sequence, NUM_KEYFRAMES);
+
+    if (!uiEventsInit()) {
+        Serial.println("Failed to create UI event queue");
     }
+
+#ifdef RUN_BENCHMARKS
+    // Benchmark build: run the suite once, then continue normal operation.
+    // Must run before the motion task exists -- the suite stages targets
+    // into the arbiter and TX queue and relies on nothing draining them
+    // to the UART (or mutating the same state from the other core).
+    runBenchmarks();
+#endif
+
+    // Start the motion task on the other core once all of the state it
+    // touches (Maestro serial, mode globals, UI event queue) is ready.
+    xTaskCreatePinnedToCore(motionTask, "motion", MOTION_TASK_STACK_SIZE,
+                            NULL, MOTION_TASK_PRIORITY, NULL, MOTION_CORE);
+
+    // Background flash writer for OTA images (runs in render-core slack)
+    otaUpdate.startTask();
 }
 
 void loop()
 {
     unsigned long currentTime = millis();
-    static unsigned long advertising_delay = 0;
 
-    // Handle BLE client disconnecting
-    if (!deviceConnected) {
-        // Use a non-blocking delay to restart advertising
-        if(currentTime > advertising_delay) {
-            BLEDevice::startAdvertising();
-            Serial.println("start advertising");
-            // wait 500ms before trying again
-            advertising_delay = currentTime + 500;
+    // Idle governor: downclock and stretch both loops when nothing needs
+    // us, snap back to full rate the moment a client connects or playback
+    // starts. Entry is delayed so a brief disconnect doesn't thrash the
+    // CPU frequency.
+    bool systemActive = deviceConnected || !sequencePaused ||
+                        talkingStartTime != 0 || talkEnvelope.active();
+    if (systemActive) {
+        lastActivityTime = currentTime;
+        if (idleGoverned) {
+            setCpuFrequencyMhz(CPU_FREQ_ACTIVE_MHZ);
+            idleGoverned = false;
+            motionTaskIdle = false;
         }
+    } else if (!idleGoverned &&
+               currentTime - lastActivityTime > IDLE_ENTER_DELAY_MS) {
+        setCpuFrequencyMhz(CPU_FREQ_IDLE_MHZ);
+        idleGoverned = true;
+        motionTaskIdle = true;
     }
 
-    // Automatic blinker
-    if (currentTime - last_blink_time > next_blink_interval) {
-        trigger_blink();
-        last_blink_time = currentTime;
-        next_blink_interval = random(BLINK_INTERVAL_MIN_MS, BLINK_INTERVAL_MAX_MS);
+    // A flashed OTA image waits for this natural idle before swapping, so
+    // the ~2s reboot lands between shows rather than mid-performance
+    if (idleGoverned && otaUpdate.readyToApply()) {
+        otaUpdate.applyAndReboot();
     }
 
-    // Handle animation based on current operation mode
-    switch (currentMode) {
-        case OperationMode::SCRIPTED:
-            handleScriptedMode(currentTime);
-            break;
-        case OperationMode::DYNAMIC:
-            handleDynamicMode(currentTime);
-            break;
+    // Renegotiate the connection interval to match traffic: fast under
+    // command bursts or a live envelope stream, slow once the link idles
+    connParams.service(currentTime, commandRing.pushed(), talkEnvelope.active());
+
+    // Fire due render-side events (blink, advertising retry)
+    uiScheduler.runDue(currentTime);
+
+    // Drain UI requests posted by the motion task and the BLE callbacks.
+    // LVGL is not thread-safe, so all animation calls happen here.
+    UiEvent event;
+    while (uiEventPop(&event)) {
+        switch (event.type) {
+            case UiEventType::EYE_MOVE:
+                animate_eye_to(event.eye_h, event.eye_v, event.duration_ms);
+                uiActiveUntil = currentTime + event.duration_ms + 100;
+                break;
+            case UiEventType::BLINK:
+                trigger_blink();
+                uiActiveUntil = currentTime + DEFAULT_BLINK_CLOSE_DURATION
+                              + DEFAULT_BLINK_PAUSE_DURATION
+                              + DEFAULT_BLINK_OPEN_DURATION + 100;
+                break;
+        }
     }
 
-    // Handle jaw movement independently if talking
-    handleJawMovement(currentTime);
-
     update_pupil_color();
 
-    lv_timer_handler(); /* let the GUI do its work */
-    delay(5); /* let this time pass */
+    // When idle, LVGL only runs while an animation window is open (a blink
+    // mid-flight); otherwise the loop just services the schedulers
+    uint32_t lv_wait = IDLE_LOOP_MAX_SLEEP_MS;
+    if (!idleGoverned || (long)(currentTime - uiActiveUntil) < 0) {
+        if (renderBudget.shouldShed()) {
+            // Previous frame blew the budget: defer this one so the loop
+            // gets back to servicing events quickly. The deferred frame
+            // counts as a light iteration, disarming the shed.
+            renderBudget.noteShed();
+            renderBudget.recordWork(0);
+            lv_wait = 5;
+        } else {
+            unsigned long frameStartUs = micros();
+            lv_wait = lv_timer_handler(); /* let the GUI do its work */
+            renderBudget.recordWork(micros() - frameStartUs);
+        }
+    }
+
+    // Sleep until the earliest known deadline: the next LVGL timer or the
+    // next scheduled event, capped so cross-core UI events stay responsive
+    // (with a much looser cap when the governor has us idle)
+    unsigned long sleep_ms = idleGoverned ? IDLE_LOOP_MAX_SLEEP_MS
+                                          : UI_LOOP_MAX_SLEEP_MS;
+    unsigned long sched_wait;
+    if (uiScheduler.nextDeadline(millis(), &sched_wait) && sched_wait < sleep_ms) {
+        sleep_ms = sched_wait;
+    }
+    if (lv_wait < sleep_ms) {
+        sleep_ms = lv_wait;
+    }
+    delay(sleep_ms > 0 ? sleep_ms : 1);
 }
\ No newline at end of file
@@ -0,0 +1,52 @@
+#include "ui_events.h"
+#include "config.h"
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+
+// =============================================================================
+// CROSS-CORE UI EVENT QUEUE IMPLEMENTATION
+// =============================================================================
+
+static QueueHandle_t uiEventQueue = nullptr;
+
+bool uiEventsInit() {
+    uiEventQueue = xQueueCreate(UI_EVENT_QUEUE_LENGTH, sizeof(UiEvent));
+    return uiEventQueue != nullptr;
+}
+
+bool requestEyeMove(int16_t target_h, int16_t target_v, uint32_t duration_ms) {
+    if (uiEventQueue == nullptr) {
+        return false;
+    }
+
+    UiEvent event;
+    event.type = UiEventType::EYE_MOVE;
+    event.eye_h = target_h;
+    event.eye_v = target_v;
+    event.duration_ms = duration_ms;
+
+    // Never block the motion task on the render core; drop on overflow
+    return xQueueSend(uiEventQueue, &event, 0) == pdTRUE;
+}
+
+bool requestBlink() {
+    if (uiEventQueue == nullptr) {
+        return false;
+    }
+
+    UiEvent event;
+    event.type = UiEventType::BLINK;
+    event.eye_h = 0;
+    event.eye_v = 0;
+    event.duration_ms = 0;
+
+    return xQueueSend(uiEventQueue, &event, 0) == pdTRUE;
+}
+
+bool uiEventPop(UiEvent* event) {
+    if (uiEventQueue == nullptr) {
+        return false;
+    }
+    return xQueueReceive(uiEventQueue, event, 0) == pdTRUE;
+}
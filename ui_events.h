@@ -0,0 +1,62 @@
+#ifndef UI_EVENTS_H
+#define UI_EVENTS_H
+
+#include <stdint.h>
+
+// =============================================================================
+// CROSS-CORE UI EVENT QUEUE
+// =============================================================================
+//
+// LVGL is not thread-safe, so all rendering calls (animations, invalidation,
+// lv_timer_handler) must stay on the render core. The motion task and the BLE
+// stack run on the other core and request UI work by posting small events into
+// this queue; the render loop drains it before each lv_timer_handler() call.
+
+// Event types the motion/BLE side can request from the render side
+enum class UiEventType : uint8_t {
+    EYE_MOVE,   // Animate the eye to a new h/v offset over a duration
+    BLINK       // Trigger a single blink animation
+};
+
+// A single queued UI request. Fields beyond `type` are only meaningful
+// for EYE_MOVE events.
+struct UiEvent {
+    UiEventType type;
+    int16_t eye_h;
+    int16_t eye_v;
+    uint32_t duration_ms;
+};
+
+/**
+ * Creates the UI event queue. Must be called once in setup() before any
+ * task posts or pops events.
+ * @return true if the queue was created successfully
+ */
+bool uiEventsInit();
+
+/**
+ * Requests an eye movement animation from the render core.
+ * Safe to call from any task; never blocks (the event is dropped if the
+ * queue is full, which only happens if the render core has stalled).
+ * @param target_h Horizontal eye offset from center
+ * @param target_v Vertical eye offset from center
+ * @param duration_ms Animation duration in milliseconds
+ * @return true if the event was queued
+ */
+bool requestEyeMove(int16_t target_h, int16_t target_v, uint32_t duration_ms);
+
+/**
+ * Requests a blink animation from the render core.
+ * @return true if the event was queued
+ */
+bool requestBlink();
+
+/**
+ * Pops one pending UI event without blocking.
+ * Must only be called from the render core.
+ * @param event Output parameter receiving the event
+ * @return true if an event was dequeued, false if the queue was empty
+ */
+bool uiEventPop(UiEvent* event);
+
+#endif // UI_EVENTS_H